@@ -18,6 +18,9 @@
  * are implemented in this file.
  */
 
+// POSIX calls such as pread() and fsync() aren't declared by a strict C standard mode without it
+#define _XOPEN_SOURCE 700
+
 #include "social.h"
 
 // Globally declared standard limmits
@@ -32,2117 +35,8225 @@ struct business *all_business = NULL;
 struct organisation *all_Organisation = NULL;
 struct group *all_Group = NULL;
 
-// Throwaway character to catch new line characters
-char throwaway;
+// Pools of the nodes and the cells used to link them
 
-// Function to take input for a name
-char *name_input()
-{
+struct pool individual_pool = POOL_INIT(struct individual);
+struct pool business_pool = POOL_INIT(struct business);
+struct pool organisation_pool = POOL_INIT(struct organisation);
+struct pool group_pool = POOL_INIT(struct group);
 
-    int limit = name_limit;
+struct pool linked_individual_pool = POOL_INIT(struct linked_individual);
+struct pool linked_business_pool = POOL_INIT(struct linked_business);
+struct pool linked_organisation_pool = POOL_INIT(struct linked_organisation);
+struct pool linked_group_pool = POOL_INIT(struct linked_group);
 
-    // Creating the name string
-    char *name = (char *)malloc(name_limit * sizeof(char));
+// The same pools indexed by kind, for the nodes and for the cells pointing to a node of that kind
+struct pool *node_pools[] = {&individual_pool, &business_pool, &organisation_pool, &group_pool};
+struct pool *linked_pools[] = {&linked_individual_pool, &linked_business_pool, &linked_organisation_pool, &linked_group_pool};
 
-    // Checking for intial memory allocation success
-    if (name == NULL)
-    {
-        printf("Memory allocation failed. Please try again\n");
-        return NULL;
-    }
+// Snapshot file mapped by load_snapshot(), the strings and dates of the loaded nodes point into it
+struct snapshot_map loaded_snapshot = {NULL, 0};
 
-    int size = 0;
+// Log of the changes made since the last snapshot, closed till wal_open() is called
+struct operation_log wal = {NULL, 0, 0, 0, 0, 0, 0};
 
-    while (1)
-    {
-        // Checking array is full and reallocating if necessary
-        if (size == limit)
-        {
-            limit *= 2;
-            name = (char *)realloc(name, limit * sizeof(char)); // Doubling the previous size
+// Size a new slab aims for
+#define SLAB_BYTES 16384
 
-            if (name == NULL)
-            {
-                printf("Memory allocation failed as name too big. PLease try again\n"); // Checking if Memory allocation was successful
-                return NULL;
-            }
-        }
+// Global index from the id of a node to the node itself
 
-        // Taking input from the user
-        char c;
-        scanf("%c", &c);
+#define SLOT_EMPTY 0
+#define SLOT_USED 1
+#define SLOT_DELETED 2
 
-        // If end of the name, terminate.
-        if (c == '\n')
-        {
-            name[size] = '\0'; // Name ends, so finishing the string
-            break;
-        }
-        else
-        {
-            name[size] = c; // Character gets added to the name string
-        }
+struct id_index all_Ids = {NULL, 0, 0, 0};
 
-        size++;
-    }
+// INDEX_* flags of the indexes a loaded snapshot hasn't been added to yet
+int pending_indexes = 0;
 
-    return name; // Pointer(array) to the name is returned
-}
+// Index from the name of a node to the node(s), one for each kind
 
-// Function to take input fro a date
-struct tm *date_input()
-{
-    // Creating a new structure
-    struct tm *temp_date = (struct tm *)malloc(sizeof(struct tm));
+struct name_index all_Names[4];
 
-    // Checking for successfull allocation of memory
-    if (temp_date == NULL)
-    {
-        printf("Memory allocation failed!!. Please try again\n");
-        return NULL;
-    }
+// Inverted index from every word used in the contents to the ids of the nodes using it
 
-    // Taking input from the user
-    if (scanf("%d/%d/%d%c", &(temp_date->tm_mday), &(temp_date->tm_mon), &(temp_date->tm_year), &throwaway) != 4)
-    {
-        // Date entered is of invalid format
-        printf("Invalid date format.\n");
+struct word_index all_Words = {NULL, 0, 0};
 
-        temp_date->tm_mday = -1;
-        temp_date->tm_mon = -1;
-        temp_date->tm_year = -1;
+// Same index from every trigram (three consecutive characters) of the contents, for substring searches
 
-        return temp_date;
-    }
+struct word_index all_Trigrams = {NULL, 0, 0};
 
-    return temp_date; // Returning the pointer of the created date structure
-}
+// Reused by the content searches for the nodes they find
+void **found_nodes = NULL;
+int found_capacity = 0;
 
-// Function to take the input for content
-char *content_input()
-{
-    // Initialzing a new char pointer(array)
-    char *content = (char *)malloc(content_limit * sizeof(char));
+// Every content copied one after the other for the scans that can't use an index, stale till it is first built
 
-    // Checking for successfull memory allocation
-    if (content == NULL)
-    {
-        printf("Memory allocation failed. Please try again\n");
-        return NULL;
-    }
+struct content_arena all_Contents = {NULL, 0, 0, NULL, 0, 0, 1};
 
-    int size = 0;              // Tracks the size of the string
-    int limit = content_limit; // Determines the maximum size of the array
+// Blocked phrases every post is checked against, empty till a blocklist is loaded
 
-    while (1)
-    {
+struct pattern_set blocklist = {0};
 
-        // Checking array is full and reallocating if necessary
-        if (size == limit)
-        {
-            limit *= 2;
-            content = (char *)realloc(content, limit * sizeof(char)); // Doubling the array size
+// The posts found to have a blocked phrase, in the order they were posted
+struct match_list flagged_posts = {NULL, 0, 0};
 
-            if (content == NULL) // Checking if reallocation was successful
-            {
-                printf("Memory allocation failed as content too big. PLease try again\n");
-                free(content);
-                return NULL;
-            }
-        }
+// Individuals by the day and month of their birthday
 
-        // Taking input from the user
-        char c;
-        scanf("%c", &c);
+struct birthday_bucket all_Birthdays[BIRTHDAY_BUCKETS];
+int birthday_count = 0;
 
-        // If end of the content, terminate.
-        if (c == '\n')
-        {
-            content[size] = '\0';
-            break;
-        }
-        else
-        {
-            content[size] = c;
-        }
+// k-d trees over the coordinates of the businesses, organisations and groups, indexed by kind
 
-        size++;
-    }
+struct spatial_index all_Places[4];
 
-    return content; // returning the pointer(array)
-}
+// Reused by the spatial queries for the places they find
+struct place_hit *found_places = NULL;
+int found_places_count = 0;
+int found_places_capacity = 0;
 
-// Function to take input for a birthday
-struct tm *birthday_input()
-{
+// Reused by the feed queries, for the posts they collect and the heap merging the post logs
+struct feed_item *feed_items = NULL;
+int feed_capacity = 0;
 
-    // Taking data from the user
-    printf("Will you input a birthday?? (Y/N)\n");
-    char c;
-    scanf("%c%c", &c, &throwaway);
+struct feed_source *feed_heap = NULL;
+int feed_heap_capacity = 0;
 
-    while (c != 'Y' && c != 'y' && c != 'n' && c != 'N')
-    {
-        printf("Error!! PLease input either Y (yes) or N (no)\n");
-        scanf("%c%c", &c, &throwaway);
-    }
+// Reused by the blocklist searches for the matches they find
+struct match_list found_matches = {NULL, 0, 0};
 
-    // Take birthday if yes
-    if (c == 'Y' || c == 'y')
-    {
+// CSR snapshot of the links between the nodes, stale till it is first built
 
-        printf("Enter your birthday\n");
-        struct tm *temp = date_input();
-        return temp;
-    }
-    else
-    {
+struct csr_graph membership_graph = {0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, 0, 1};
 
-        struct tm *temp_date;
+// Buffer reused by every two-hop query to collect it's nodes
 
-        temp_date->tm_mday = -1;
-        temp_date->tm_mon = -1;
-        temp_date->tm_year = -1;
+int *two_hop_buffer = NULL;
+int two_hop_capacity = 0;
 
-        return temp_date;
-    }
-}
+// Buffers reused by every k-hop query, for the nodes it reaches level by level and the frontier as a bitmap
 
-// Function to print a given node
-void print_node(void *node, char type[])
-{
+int *k_hop_nodes = NULL;
+int k_hop_capacity = 0;
 
-    if (node == NULL) // Empty node check
-        return;
+int *k_hop_ends = NULL;
+int k_hop_ends_capacity = 0;
 
-    if (strcmp(type, "Individual") == 0) // If the given node is of Individual type
-    {
-        struct individual *temp_ind = (struct individual *)node; // Creating a temporary (typecasted) node to work with
+unsigned long long *k_hop_frontier = NULL;
+unsigned long long *k_hop_visited = NULL;
+int k_hop_frontier_words = 0;
 
-        // Printing the attributes
+// Buffers reused by every shortest path query, indexed by the dense index of a node
 
-        printf("\nName of the %s :- %s\n", type, temp_ind->name);
-        printf("\nID- %d\n", temp_ind->id);
-        printf("\nCreation date :- %d/%d/%d\n", temp_ind->creation->tm_mday, temp_ind->creation->tm_mon, temp_ind->creation->tm_year);
-        printf("145\n");
-        printf("\nContent :- \n%s\n", temp_ind->content);
+int *path_parents = NULL;
+int *path_depths = NULL;
+int *path_queue = NULL;
+int path_capacity = 0;
 
-        // Checking if a valid birthday exists
-        if (temp_ind->birthday->tm_mday == -1)
-            printf("\nHas no valid birthday\n\n");
-        else
-            printf("Birthday :- %d/%d/%d\n\n", temp_ind->birthday->tm_mday, temp_ind->birthday->tm_mon, temp_ind->birthday->tm_year);
-    }
-    else if (strcmp(type, "Business") == 0) // If the given node is of Business type
-    {
-        struct business *temp_bus = (struct business *)node; // Temporary pointer to access the node data
+// The last shortest path found, from the first node to the second one
+int *path_nodes = NULL;
+int path_length = 0;
 
-        // Printing the attributes
+// Connected components of the graph, kept up to date as nodes and links are created
 
-        printf("\nName of the %s :- %s\n", type, temp_bus->name);
-        printf("\nID- %d\n", temp_bus->id);
-        printf("\nCreation date :- %d/%d/%d\n", temp_bus->creation->tm_mday, temp_bus->creation->tm_mon, temp_bus->creation->tm_year);
-        printf("\nContent :-\n%s\n", temp_bus->content);
+struct union_find node_components = {NULL, NULL, 0, 0, 0, 0};
 
-        printf("\nThe co-ordinates of the business are (%.3lf, %.3lf) \n", temp_bus->x_cord, temp_bus->y_cord);
+// Reused by components_collect() for the components it lists
+struct component_info *found_components = NULL;
+int found_components_capacity = 0;
 
-        // Printing the owners and the customers
-        if (temp_bus->owners != NULL)
-        {
-            struct linked_individual *temp = temp_bus->owners;
+// Score vectors of the PageRank computations, and the one running in the background if any
 
-            int num = 1; // Count of nodes
-            printf("\nList of owner(s)\n\n");
+double *pagerank_vectors = NULL;
+int pagerank_capacity = 0;
 
-            while (temp != NULL)
-            {
-                printf("%d) %s\n", num++, temp->node_ind->name); // Printing the owner's names
+double *pagerank_partials = NULL;
+int pagerank_partials_capacity = 0;
 
-                temp = temp->next;
-            }
-        }
-        else
-            printf("\nThere are no owners\n");
+int pagerank_ready = 0;     // Set once the nodes have been scored
 
-        if (temp_bus->customers != NULL)
-        {
-            struct linked_individual *temp = temp_bus->customers;
+struct pagerank_job pagerank_background = {0};
 
-            int num = 1; // Count of nodes
-            printf("\nList of customer(s)\n");
+// Threads the k-hop levels are expanded by, only the calling thread till thread_pool_start() is asked for more
 
-            while (temp != NULL)
-            {
-                printf("%d) %s\n", num++, temp->node_ind->name); // Printing the customer's name
+struct thread_pool bfs_pool = {NULL, 1, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0, 0, 0};
 
-                temp = temp->next;
-            }
-        }
-        else
-            printf("\nThere are no customers\n");
-    }
-    else if (strcmp(type, "Organisation") == 0) // If the given node is of Organisation type
-    {
-        struct organisation *temp_org = (struct organisation *)node; // Temporary pointer to access the node data
+struct bfs_worker *bfs_workers = NULL;
+int bfs_worker_count = 0;
 
-        // Printing the attributes
+// Throwaway character to catch new line characters
+char throwaway;
 
-        printf("Name of the %s :- %s\n", type, temp_org->name);
-        printf("ID- %d\n", temp_org->id);
-        printf("Creation date :- %d/%d/%d\n", temp_org->creation->tm_mday, temp_org->creation->tm_mon, temp_org->creation->tm_year);
-        printf("Content :-\n%s\n", temp_org->content);
+// Function to add a slab of count objects to the free list of a pool
+static int pool_add_slab(struct pool *pool, size_t count)
+{
+    struct slab *new_slab = (struct slab *)malloc(sizeof(struct slab) + count * pool->object_size);
 
-        printf("The co-ordinates of the organisation are (%.3lf, %.3lf) \n", temp_org->x_cord, temp_org->y_cord);
+    // Checking for successfull memory allocation
+    if (new_slab == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
+    }
 
-        // Printing the Individual members
+    new_slab->count = count;
+    new_slab->next = pool->slabs;
+    pool->slabs = new_slab;
+    pool->capacity += count;
 
-        if (temp_org->orgmember_head != NULL)
-        {
-            struct linked_individual *temp = temp_org->orgmember_head;
+    // Threading the objects onto the free list, the first object ends up in front
+    char *objects = (char *)(new_slab + 1);
 
-            int num = 1; // Count of nodes
-            printf("\nList of Individual member(s)\n");
+    for (size_t i = count; i > 0; i--)
+    {
+        void *object = objects + (i - 1) * pool->object_size;
+        *(void **)object = pool->free_list;
+        pool->free_list = object;
+    }
 
-            while (temp != NULL)
-            {
-                printf("%d) %s\n", num++, temp->node_ind->name); // Printing the names
+    return 1;
+}
 
-                temp = temp->next;
-            }
-        }
-        else
-            printf("\nThere are no Individual members\n");
-    }
-    else if (strcmp(type, "Group") == 0) // If the given node is of Group type
+// Function to allocate an object from a pool
+void *pool_alloc(struct pool *pool)
+{
+    if (pool->free_list == NULL)
     {
-        struct group *temp_grp = (struct group *)node; // Temporary pointer to access the node data
-
-        // Printing the attributes
+        // No free objects left, so a new slab is carved up into them
+        if (!pool_reserve(pool, 1))
+            return NULL;
+    }
 
-        printf("\nName of the %s :- %s\n", type, temp_grp->name);
-        printf("\nID- %d\n", temp_grp->id);
-        printf("\nCreation date :- %d/%d/%d\n", temp_grp->creation->tm_mday, temp_grp->creation->tm_mon, temp_grp->creation->tm_year);
-        printf("\nContent :-\n%s\n", temp_grp->content);
+    // Taking the first free object
+    void *object = pool->free_list;
+    pool->free_list = *(void **)object;
+    pool->in_use++;
 
-        printf("The co-ordinates of the group are (%.3lf, %.3lf) \n", temp_grp->x_cord, temp_grp->y_cord);
+    return object;
+}
 
-        // Printing the Individual and Business members
+// Function to make sure a pool can hand out count more objects without allocating
+int pool_reserve(struct pool *pool, size_t count)
+{
+    size_t free_objects = pool->capacity - pool->in_use;
 
-        if (temp_grp->grpmember_head != NULL)
-        {
-            struct linked_individual *temp = temp_grp->grpmember_head;
+    if (count <= free_objects)
+        return 1;
 
-            int num = 1; // Counts of nodes
-            printf("\nList of individual member(s)\n");
+    // Adding the usual sized slabs, so that pool_compact() can still give back the ones left empty later
+    size_t slab_objects = SLAB_BYTES / pool->object_size;
 
-            while (temp != NULL)
-            {
-                printf("%d) %s\n", num++, temp->node_ind->name); // Printing the Individual's name
+    if (slab_objects == 0)
+        slab_objects = 1;
 
-                temp = temp->next;
-            }
-        }
-        else
-            printf("\nThere are no individual members\n\n");
+    for (size_t added = free_objects; added < count; added += slab_objects)
+    {
+        if (!pool_add_slab(pool, slab_objects))
+            return 0;
+    }
 
-        if (temp_grp->businessmember_head != NULL)
-        {
-            struct linked_business *temp2 = temp_grp->businessmember_head;
+    return 1;
+}
 
-            int num = 1; // Count of nodes
-            printf("List of business member(s)\n\n");
+// Function to give an object back to it's pool
+void pool_free(struct pool *pool, void *object)
+{
+    if (object == NULL)
+        return;
 
-            while (temp2 != NULL)
-            {
-                printf("%d) %s\n", num++, temp2->node_bus->name); // Printing the Businesse's name
+    *(void **)object = pool->free_list;
+    pool->free_list = object;
+    pool->in_use--;
+}
 
-                temp2 = temp2->next;
-            }
-        }
-        else
-            printf("\nThere are no business members\n");
-    }
+// Function to check if a pointer points into the mapped snapshot
+int in_snapshot(void *pointer)
+{
+    char *address = (char *)pointer;
+    char *base = (char *)loaded_snapshot.base;
 
-    printf("\n*******************\n");
+    return base != NULL && address >= base && address < base + loaded_snapshot.size;
 }
 
-// Function search for a node with the given search_parameter
-void search(char search_parameter[])
+// Function to free an attribute of a node, unless it is part of the mapped snapshot
+void release_memory(void *pointer)
 {
+    if (in_snapshot(pointer))
+        return; // Stays mapped till the program exits
 
-    int flag = 1;
+    free(pointer);
+}
 
-    // Temporary iterators(pointers) to travel over the nodes
+// Function to compare two addresses, for sorting
+static int compare_addresses(const void *a, const void *b)
+{
+    char *x = *(char **)a;
+    char *y = *(char **)b;
 
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+    return (x > y) - (x < y);
+}
 
-    while (temp_ind != NULL)
-    {
+// Function to compare two slabs by the number of objects in use, fullest first
+static int compare_slab_use(const void *a, const void *b)
+{
+    const struct slab_use *x = (const struct slab_use *)a;
+    const struct slab_use *y = (const struct slab_use *)b;
 
-        if (!(strcmp(search_parameter, temp_ind->name)))
-        {
+    return (y->live > x->live) - (y->live < x->live);
+}
 
-            flag = 0;
+// Function to pack the objects of a pool into as few slabs as possible and free the slabs left empty
+size_t pool_compact(struct pool *pool, void (*move)(void *from, void *to))
+{
+    size_t slab_count = 0;
+    size_t free_count = pool->capacity - pool->in_use;
 
-            printf("\nThe node is:- \n\n");
-            print_node(temp_ind, "Individual");
-        }
-        else if (!(strcmp(search_parameter, "Individual")))
-        {
+    for (struct slab *temp = pool->slabs; temp != NULL; temp = temp->next)
+        slab_count++;
 
-            if (flag)
-            {
-                flag = 0;
-                printf("\nThe Individual node(s) are:-\n");
-            }
+    if (slab_count < 2 || free_count == 0)
+        return 0; // Nothing to gain
 
-            print_node(temp_ind, "Individual");
-        }
+    struct slab_use *slabs = (struct slab_use *)malloc(slab_count * sizeof(struct slab_use));
+    char **free_objects = (char **)malloc(free_count * sizeof(char *));
 
-        temp_ind = temp_ind->next;
-    }
-    while (temp_bus != NULL)
+    if (slabs == NULL || free_objects == NULL)
     {
+        free(slabs);
+        free(free_objects);
+        return 0;
+    }
 
-        if (!(strcmp(search_parameter, temp_bus->name)))
-        {
+    // Sorting the slabs and the free objects by address, so that each free object can be matched to it's slab
+    size_t index = 0;
 
-            flag = 0;
+    for (struct slab *temp = pool->slabs; temp != NULL; temp = temp->next, index++)
+    {
+        slabs[index].slab = temp;
+        slabs[index].live = temp->count;
+    }
 
-            printf("\nThe node is:- \n\n");
-            print_node(temp_bus, "Business");
-        }
-        else if (!(strcmp(search_parameter, "Business")))
-        {
+    index = 0;
 
-            if (flag)
-            {
-                flag = 0;
-                printf("\nThe Business node(s) are:-\n");
-            }
+    for (void *object = pool->free_list; object != NULL; object = *(void **)object)
+        free_objects[index++] = (char *)object;
 
-            print_node(temp_bus, "Business");
-        }
+    qsort(slabs, slab_count, sizeof(struct slab_use), compare_addresses);
+    qsort(free_objects, free_count, sizeof(char *), compare_addresses);
 
-        temp_bus = temp_bus->next;
-    }
-    while (temp_org != NULL)
+    size_t first_free = 0;
+
+    for (size_t i = 0; i < slab_count; i++)
     {
+        char *end = (char *)(slabs[i].slab + 1) + slabs[i].slab->count * pool->object_size;
 
-        if (!(strcmp(search_parameter, temp_org->name)))
-        {
+        slabs[i].first_free = first_free;
 
-            flag = 0;
+        while (first_free < free_count && free_objects[first_free] < end)
+            first_free++;
 
-            printf("\nThe node is:- \n\n");
-            print_node(temp_org, "Organisation");
-        }
-        else if (!(strcmp(search_parameter, "Organisation")))
-        {
+        slabs[i].free_count = first_free - slabs[i].first_free;
+        slabs[i].live -= slabs[i].free_count;
+    }
 
-            if (flag)
-            {
-                flag = 0;
-                printf("\nThe Organisation node(s) are:-\n");
-            }
+    // Keeping the fullest slabs, just enough of them to hold every object in use
+    qsort(slabs, slab_count, sizeof(struct slab_use), compare_slab_use);
 
-            print_node(temp_org, "Organisation");
-        }
+    size_t kept = 0;
+    size_t kept_capacity = 0;
 
-        temp_org = temp_org->next;
-    }
-    while (temp_grp != NULL)
-    {
+    while (kept < slab_count && kept_capacity < pool->in_use)
+        kept_capacity += slabs[kept++].slab->count;
 
-        if (!(strcmp(search_parameter, temp_grp->name)))
-        {
+    if (kept == 0)
+        kept = 1; // The pool always keeps a slab
 
-            flag = 0;
+    size_t released = 0;
 
-            printf("\nThe node is:- \n\n");
-            print_node(temp_grp, "Group");
-        }
-        else if (!(strcmp(search_parameter, "Group")))
+    if (kept < slab_count)
+    {
+        // Every object still in use in the other slabs is moved into a hole of the kept ones
+        size_t hole_slab = 0;
+        size_t hole = 0;
+
+        for (size_t i = kept; i < slab_count; i++)
         {
+            char *object = (char *)(slabs[i].slab + 1);
+            size_t next_free = slabs[i].first_free;
 
-            if (flag)
+            for (size_t j = 0; j < slabs[i].slab->count; j++, object += pool->object_size)
             {
-                flag = 0;
-                printf("\nThe Group node(s) are:-\n");
-            }
+                if (next_free < slabs[i].first_free + slabs[i].free_count && free_objects[next_free] == object)
+                {
+                    next_free++; // Free already
+                    continue;
+                }
 
-            print_node(temp_grp, "Group");
-        }
+                while (hole == slabs[hole_slab].free_count)
+                {
+                    hole_slab++;
+                    hole = 0;
+                }
 
-        temp_grp = temp_grp->next;
-    }
+                char *target = free_objects[slabs[hole_slab].first_free + hole];
 
-    if (flag)
-        printf("No match found\n");
-}
+                free_objects[slabs[hole_slab].first_free + hole] = NULL; // The hole is filled
+                hole++;
 
-// Function to search by id
-void *search_by_id(int id)
-{
-    int flag = 1;
+                move(object, target);
+            }
+        }
 
-    // Temporary iterators over the global linked list to search
+        // Giving the emptied slabs back
+        for (size_t i = kept; i < slab_count; i++)
+        {
+            pool->capacity -= slabs[i].slab->count;
+            free(slabs[i].slab);
+            released++;
+        }
+    }
 
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+    // Rebuilding the slab list and the free list from the kept slabs and their remaining holes
+    pool->slabs = NULL;
+    pool->free_list = NULL;
 
-    while (temp_ind != NULL)
+    for (size_t i = kept; i > 0; i--)
     {
-        if (temp_ind->id == id)
-            return (struct individual *)temp_ind;
+        struct slab_use *use = &slabs[i - 1];
 
-        temp_ind = temp_ind->next;
-    }
-    while (temp_bus != NULL)
-    {
-        if (temp_bus->id == id)
-            return (struct business *)temp_bus;
+        use->slab->next = pool->slabs;
+        pool->slabs = use->slab;
 
-        temp_bus = temp_bus->next;
-    }
-    while (temp_org != NULL)
-    {
-        if (temp_org->id == id)
-            return (struct organsiation *)temp_org;
+        for (size_t j = use->first_free + use->free_count; j > use->first_free; j--)
+        {
+            if (free_objects[j - 1] == NULL)
+                continue;
 
-        temp_org = temp_org->next;
+            *(void **)free_objects[j - 1] = pool->free_list;
+            pool->free_list = free_objects[j - 1];
+        }
     }
-    while (temp_grp != NULL)
-    {
-        if (temp_grp->id == id)
-            return (struct group *)temp_grp;
 
-        temp_grp = temp_grp->next;
-    }
+    free(slabs);
+    free(free_objects);
 
-    if (flag)                               // There is no match
-    {
-        printf("No such node exists\n");
-        return NULL;
-    }
+    return released;
 }
 
-// Function to search by birthday
-void search_by_birthday(struct tm *search_date)
+// Hash function for the ids (Fibonacci hashing spreads consecutive ids over the table)
+static unsigned int id_hash(int id)
+{
+    return (unsigned int)id * 2654435769u;
+}
+
+// Function to rebuild the ID index with a given capacity
+static int id_index_rehash(int new_capacity)
 {
-    // A individual iterator since only individuals have birthdays
-    struct individual *temp = all_Individuals;
+    struct id_slot *new_slots = (struct id_slot *)calloc(new_capacity, sizeof(struct id_slot));
 
-    int flag = 1;
-    while (temp != NULL)
+    // Checking for successfull memory allocation
+    if (new_slots == NULL)
     {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
+    }
 
-        if (temp->birthday->tm_mday == search_date->tm_mday && temp->birthday->tm_mon == search_date->tm_mon                        // Checking if the dates match and 
-            && temp->birthday->tm_year == search_date->tm_year && search_date->tm_mday != -1 && temp->birthday->tm_mday != -1)      // neither of them are invalid
-        {
-            if (flag)
-            {
-                printf("The node(s) are :- \n\n");
-                flag = 0;
-            }
+    unsigned int mask = new_capacity - 1;
 
-            print_node(temp, "Individual");                                                             // Printing all the nodes who match
-        }
+    // Moving every used slot into the new table, tombstones are dropped
+    for (int i = 0; i < all_Ids.capacity; i++)
+    {
+        if (all_Ids.slots[i].state != SLOT_USED)
+            continue;
+
+        unsigned int pos = id_hash(all_Ids.slots[i].id) & mask;
 
-        temp = temp->next;                                                                              // Iterating through the lsilist
+        while (new_slots[pos].state == SLOT_USED)
+            pos = (pos + 1) & mask; // Linear probing
+
+        new_slots[pos] = all_Ids.slots[i];
     }
 
-    if (flag)
-        printf("There are no nodes with the given birthday\n\n");                                       // If there are no matches 
-}
+    free(all_Ids.slots);
 
-// Function to print the content of a node
-void print_content(int id)
-{
-    int flag = 1;
+    all_Ids.slots = new_slots;
+    all_Ids.capacity = new_capacity;
+    all_Ids.tombstones = 0;
 
-    // Temporary iterators to search
+    return 1;
+}
 
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+// Function to make sure the ID index can hold count nodes
+int id_index_reserve(int count)
+{
+    int capacity = 16;
 
-    while (temp_ind != NULL)                                                        // Iterting over all the individuals
-    {
-        if (temp_ind->id == id)                                                     // If a match is found
-        {
-            printf("The content of the node with ID %d is:- \n", id);               // Printing the name and content
-            printf("\n%s\n\n", temp_ind->content);                                  // of the node found
+    // Keeping the load factor below 70%
+    while ((long long)capacity * 7 < (long long)count * 10)
+        capacity *= 2;
 
-            return;
-        }
+    if (capacity > all_Ids.capacity)
+        return id_index_rehash(capacity);
 
-        temp_ind = temp_ind->next;                                                  // Iterating over all the individuals
-    }
-    while (temp_bus != NULL)
-    {
-        if (temp_bus->id == id)                                                     // If a match is found
-        {
-            printf("The content of the node with ID %d is:- \n", id);               // Printing the name and content
-            printf("\n%s\n\n", temp_bus->content);                                  // of the node found
+    // Big enough, but the tombstones may still have filled it up, so they are cleared out
+    if ((long long)all_Ids.capacity * 7 < (long long)(count + all_Ids.tombstones) * 10)
+        return id_index_rehash(all_Ids.capacity);
 
-            return;
-        }
+    return 1;
+}
 
-        temp_bus = temp_bus->next;                                                  // Iterating over all the bsuinesses
-    }
-    while (temp_org != NULL)
-    {
-        if (temp_org->id == id)                                                     // If a match is found
-        {
-            printf("The content of the node with ID %d is:- \n", id);               // Printing the name and content
-            printf("\n%s\n\n", temp_org->content);                                  // of the node found
+// Function to find the slot of a node with a given id
+struct id_slot *id_index_find(int id)
+{
+    if (all_Ids.used == 0)
+        return NULL;
 
-            return;
-        }
+    unsigned int mask = all_Ids.capacity - 1;
+    unsigned int pos = id_hash(id) & mask;
 
-        temp_org = temp_org->next;                                                  // Iterating over all the organisations
-    }
-    while (temp_grp != NULL)
+    // Probing till an empty slot is found, tombstones are skipped over
+    while (all_Ids.slots[pos].state != SLOT_EMPTY)
     {
-        if (temp_grp->id == id)                                                     // If a match is found
-        {
-            printf("The content of the node with ID %d is:- \n\n", id);             // Printing the name and content
-            printf("\n%s\n\n", temp_grp->content);                                  // of the node found
-
-            return;
-        }
+        if (all_Ids.slots[pos].state == SLOT_USED && all_Ids.slots[pos].id == id)
+            return &all_Ids.slots[pos];
 
-        temp_grp = temp_grp->next;                                                  // Iterating over all the organisations
+        pos = (pos + 1) & mask;
     }
 
-    printf("No such node exists\n");                                                // Checking if there is no node matching 
+    return NULL;
 }
 
-// Function to search nodes to link them
-void *search_to_link(char search_parameter[], char type[])
+// Function to add a node to the ID index
+int id_index_insert(int id, enum node_kind kind, void *node)
 {
+    if (id_index_find(id) != NULL) // Ids have to be unique
+        return 0;
 
-    // Temporary iterators to search
+    if (!id_index_reserve(all_Ids.used + 1))
+        return 0;
 
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
+    unsigned int mask = all_Ids.capacity - 1;
+    unsigned int pos = id_hash(id) & mask;
 
-    while (temp_ind != NULL && !(strcmp(type, "Individual")))                        // If type is of Individual
-    {
-        if (!(strcmp(search_parameter, temp_ind->name)))                             // Checking a match of the name
-            return (struct individual *)temp_ind;
+    // Any slot that isn't in use can be taken, a tombstone included
+    while (all_Ids.slots[pos].state == SLOT_USED)
+        pos = (pos + 1) & mask;
 
-        temp_ind = temp_ind->next;                                                   // Iterating over the global list
-    }
+    if (all_Ids.slots[pos].state == SLOT_DELETED)
+        all_Ids.tombstones--;
 
-    while (temp_bus != NULL && !(strcmp(type, "Business")))                          // If the type is Business
-    {
-        if (!(strcmp(search_parameter, temp_bus->name)))                             // Chekcing for a match of the name
-            return (struct business *)temp_bus;
+    all_Ids.slots[pos].id = id;
+    all_Ids.slots[pos].state = SLOT_USED;
+    all_Ids.slots[pos].kind = (unsigned char)kind;
+    all_Ids.slots[pos].node = node;
 
-        temp_bus = temp_bus->next;                                                   // Iterating over the global list
-    }
+    all_Ids.used++;
 
-    return NULL;                                                                     // NULL is returned if a node isn't found
+    return 1;
 }
 
-// Function to create a new  node
-void new_node(char type[])
+// Function to remove a node from the ID index
+void id_index_remove(int id)
 {
-    if (!(strcmp(type, "Individual")))
-    {
-        // Allocation memory for a new Individual type node
-        struct individual *ind_node = (struct individual *)malloc(sizeof(struct individual));
+    struct id_slot *slot = id_index_find(id);
 
-        // Checking if allocation was successful
-        if (ind_node == NULL)
-        {
-            printf("Memory allocation failed. Please try again\n");
-        }
+    if (slot == NULL)
+        return;
 
-        // Setting the type to Individual
-        strcpy(ind_node->type, "Individual");
+    slot->state = SLOT_DELETED; // Left as a tombstone so that later ids in the probe sequence are still found
+    slot->node = NULL;
 
-        // Taking inputs for the common attributes
+    all_Ids.used--;
+    all_Ids.tombstones++;
+}
 
-        printf("\nEnter the ID of the individual\n");
-        scanf("%d%c", &(ind_node->id), &throwaway);
+// Function to mark the CSR snapshot as out of date
+void csr_mark_stale()
+{
+    membership_graph.stale = 1;
+}
 
-        printf("Enter the name\n");
-        ind_node->name = name_input();
+// Function to write the dense indices of the neighbours of a node, or just count them if out is NULL
+static int csr_node_links(void *node, int *out)
+{
+    int count = 0;
 
-        printf("Enter the creation date in the format DD/MM/YYYY: \n");
-        ind_node->creation = date_input();
+    // The order is the same in which one_hop() prints the nodes
 
-        printf("Enter the content of the Individual\n");
-        ind_node->content = content_input();
+    if (NODE_KIND(node) == NODE_INDIVIDUAL)
+    {
+        struct individual *temp_ind = (struct individual *)node;
 
-        // Input for unique attribute
-        ind_node->birthday = birthday_input();
+        for (struct linked_business *temp = temp_ind->back_bus; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_bus->csr_index;
 
-        // Initializing the back pointers to NULL
+        for (struct linked_organisation *temp = temp_ind->back_org; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_org->csr_index;
 
-        ind_node->back_bus = NULL;
-        ind_node->back_grp = NULL;
-        ind_node->back_org = NULL;
+        for (struct linked_group *temp = temp_ind->back_grp; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_grp->csr_index;
+    }
+    else if (NODE_KIND(node) == NODE_BUSINESS)
+    {
+        struct business *temp_bus = (struct business *)node;
 
-        // Linking the created node to the global list
-        ind_node->next = all_Individuals;
-        all_Individuals = ind_node;
+        for (struct linked_group *temp = temp_bus->back_grp; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_grp->csr_index;
 
-        printf("******** Node successfully created ********\n");
+        for (struct linked_individual *temp = temp_bus->owners; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_ind->csr_index;
+
+        for (struct linked_individual *temp = temp_bus->customers; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_ind->csr_index;
     }
-    else if (!(strcmp(type, "Business")))
+    else if (NODE_KIND(node) == NODE_ORGANISATION)
     {
-        struct business *bus_node = (struct business *)malloc(sizeof(struct business));
+        struct organisation *temp_org = (struct organisation *)node;
 
-        // Checking if allocation was successful
-        if (bus_node == NULL)
-        {
-            printf("Memory allocation failed. Please try again\n");
-        }
+        for (struct linked_individual *temp = temp_org->orgmember_head; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_ind->csr_index;
+    }
+    else
+    {
+        struct group *temp_grp = (struct group *)node;
 
-        // Setting the type to business
-        strcpy(bus_node->type, "Business");
+        for (struct linked_individual *temp = temp_grp->grpmember_head; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_ind->csr_index;
 
-        // Taking inputs for the common attributes
+        for (struct linked_business *temp = temp_grp->businessmember_head; temp != NULL; temp = temp->next, count++)
+            if (out != NULL)
+                out[count] = temp->node_bus->csr_index;
+    }
 
-        printf("\nEnter the ID of the business\n");
-        scanf("%d%c", &(bus_node->id), &throwaway);
+    return count;
+}
 
-        printf("Enter the name of the business\n");
-        bus_node->name = name_input("Business");
+// Function to grow an array of the snapshot, keeping it as it is if it is already big enough
+static int csr_reserve(void **array, int *capacity, int count, size_t size)
+{
+    if (count <= *capacity)
+        return 1;
 
-        printf("Enter the creation date in the format DD/MM/YYYY\n");
-        bus_node->creation = date_input();
+    void *temp = realloc(*array, (size_t)count * size);
 
-        printf("Enter the content of the business\n");
-        bus_node->content = content_input();
+    if (temp == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
+    }
 
-        // Initializing the back pointer to NULL'
-        bus_node->back_grp = NULL;
+    *array = temp;
+    return 1;
+}
 
-        // Inputs for the unique attributes
+// Function to add a node to the snapshot being built
+static void csr_add_node(struct csr_graph *graph, void *node, int *index)
+{
+    NODE_CSR_INDEX(node) = *index;
 
-        printf("\nEnter the X Co-ordinate\n");
-        scanf("%lf%c", &(bus_node->x_cord), &throwaway);
+    graph->nodes[*index] = node;
+    graph->kinds[*index] = (unsigned char)NODE_KIND(node);
 
-        printf("Enter the Y Co-ordinate\n");
-        scanf("%lf%c", &(bus_node->y_cord), &throwaway);
+    (*index)++;
+}
 
+// Function to count the nodes present, every one of them is taken from the pool of it's kind
+static int network_size()
+{
+    size_t count = 0;
 
-        char check;                                             // Character used to check if there are any members
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+        count += node_pools[kind]->in_use;
 
-        bus_node->owners = NULL;                                // Initializing the owners list to NULL
-        bus_node->customers = NULL;                             // Initializing the customers list to NULL
+    return (int)count;
+}
 
-        printf("\nDo you want to enter any owner(s) (Y/N)\n");
-        scanf("%c%c", &check, &throwaway);                      // Taking input from the user
+// Function to get an up to date CSR snapshot of the graph
+struct csr_graph *csr_snapshot()
+{
+    struct csr_graph *graph = &membership_graph;
 
-        while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')            // Checking whether a correct character has been used or not
-        {
-            printf("Error!! Please enter the correct characer (Y/N)\n");                // Iterating till the correct character is used
-            scanf("%c%c", &check, &throwaway);
-        }
+    if (!graph->stale)
+        return graph;
 
-        if (check == 'Y' || check == 'y')                                               // If the user has given a yes
-        {
-            while (check == 'Y' || check == 'y')                                        // Loop to add new owners
-            {
-                printf("Enter the name of owner\n");
+    int node_count = network_size();
+    int capacity = graph->node_capacity;
 
-                char *customer_name = name_input();
+    // Growing the per node arrays if needed, the capacity is only updated once all of them have grown
+    if (!csr_reserve((void **)&graph->nodes, &capacity, node_count + 1, sizeof(void *)) ||
+        !csr_reserve((void **)&graph->kinds, &capacity, node_count + 1, sizeof(unsigned char)) ||
+        !csr_reserve((void **)&graph->stamps, &capacity, node_count + 1, sizeof(unsigned int)) ||
+        !csr_reserve((void **)&graph->offsets, &capacity, node_count + 1, sizeof(int)))
+        return NULL;
 
-                struct individual *temp_ind = (struct individual *)search_to_link(customer_name, "Individual");     // Finding the owner name
+    if (node_count + 1 > graph->node_capacity)
+        graph->node_capacity = node_count + 1;
 
-                if (temp_ind == NULL)
-                    printf("Such a name doesn't exist\n");
-                else
-                {
-                    // Creating a new linked individual* node to store the pointer of the new owner found
-                    struct linked_individual *new_owner = (struct linked_individual *)malloc(sizeof(struct linked_individual));
+    // First pass, handing out the dense indices in the order of the global lists
 
-                    // Assigning the business as a back pointer to the temp_ind Individual
-                    struct linked_business *bus_back = (struct linked_business *)malloc(sizeof(struct linked_business));
-                    bus_back->node_bus = bus_node;
-                    bus_back->next = temp_ind->back_bus;
-                    temp_ind->back_bus = bus_back;
+    int index = 0;
 
-                    // Now assigning this Individual node's pointer to the business
-                    new_owner->node_ind = temp_ind;
-                    new_owner->next = bus_node->owners;
-                    bus_node->owners = new_owner;
+    for (struct individual *temp = all_Individuals; temp != NULL; temp = temp->next)
+        csr_add_node(graph, temp, &index);
+    for (struct business *temp = all_business; temp != NULL; temp = temp->next)
+        csr_add_node(graph, temp, &index);
+    for (struct organisation *temp = all_Organisation; temp != NULL; temp = temp->next)
+        csr_add_node(graph, temp, &index);
+    for (struct group *temp = all_Group; temp != NULL; temp = temp->next)
+        csr_add_node(graph, temp, &index);
 
-                    printf("Successfully added!!\n");
-                }
+    graph->node_count = index;
 
-                printf(" Do you want to enter any other names (Y/N) ??\n");             // Asking if there are any other names
-                scanf("%c%c", &check, &throwaway);
+    // Counting the neighbours of every node to know where it's neighbours start
 
-                while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')    // Iterating till the correct name ahs been entered
-                {
-                    printf("Error!! Please enter the correct characer (Y/N)\n");
-                    scanf("%c ", &check);
-                }
-            }
-        }
+    graph->offsets[0] = 0;
 
-        printf("Do you want to enter any customer(s) (Y/N)\n");                          // Doing the same as owners for any customers
-        scanf("%c%c", &check, &throwaway);
+    for (int i = 0; i < graph->node_count; i++)
+        graph->offsets[i + 1] = graph->offsets[i] + csr_node_links(graph->nodes[i], NULL);
 
-        while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')             // Iterating till a cirrect character has been entered
-        {
-            printf("Error!! Please enter the correct characer (Y/N)\n");
-            scanf("%c%c", &check, &throwaway);
-        }
+    graph->edge_count = graph->offsets[graph->node_count];
 
-        if (check == 'Y' || check == 'y')                                                // If the ser has given a yes
-        {
-            while (check == 'Y' || check == 'y')                                         // Loop to add new customers
-            {   
-                printf("Enter the name of customer\n");
+    if (!csr_reserve((void **)&graph->neighbors, &graph->edge_capacity, graph->edge_count, sizeof(int)))
+        return NULL;
 
-                char *customer_name = name_input();
+    if (graph->edge_count > graph->edge_capacity)
+        graph->edge_capacity = graph->edge_count;
 
-                struct individual *temp_ind1 = (struct individual *)search_to_link(customer_name, "Individual");    // FInds the required node
+    // Second pass, writing the neighbours now that every node has it's index
 
-                if (temp_ind1 == NULL)
-                    printf("Such a name doesn't exist\n");
-                else
-                {
-                    // Creating a new linked_individual* node to store the pointer to the required customer individual node
-                    struct linked_individual *new_customer = (struct linked_individual *)malloc(sizeof(struct linked_individual));
+    for (int i = 0; i < graph->node_count; i++)
+        csr_node_links(graph->nodes[i], graph->neighbors + graph->offsets[i]);
 
-                    // Assgning the business as a back pointer to the temp_ind1 Individual
-                    struct linked_business *business_back = (struct linked_business *)malloc(sizeof(struct linked_business));
-                    business_back->node_bus = bus_node;
-                    business_back->next = temp_ind1->back_bus;
-                    temp_ind1->back_bus = business_back;
+    // Clearing the traversal stamps, as the indices they belonged to have changed
+    memset(graph->stamps, 0, (size_t)graph->node_count * sizeof(unsigned int));
+    graph->epoch = 0;
 
-                    // Now assigning the individual node to the customers list
-                    new_customer->node_ind = temp_ind1;
-                    new_customer->next = bus_node->owners;
-                    bus_node->owners = new_customer;
+    graph->stale = 0;
 
-                    printf("Successfully added!!\n");
-                }
+    return graph;
+}
 
-                printf("Do you want to enter any other names (Y/N) ??\n");                          // CHecking for any other customers
-                scanf("%c%c", &check, &throwaway);
+// Hash function for the names (FNV-1a)
+static unsigned int name_hash(char *name)
+{
+    unsigned int hash = 2166136261u;
 
-                while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')                // Iterating till a correct character ahs been entered
-                {
-                    printf("Error!! Please enter the correct characer (Y/N)\n");
-                    scanf("%c%c", &check, &throwaway);
-                }
-            }
-        }
+    while (*name)
+    {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
 
-        // Linking the created node to the global linked list
+    return hash;
+}
 
-        bus_node->next = all_business;
-        all_business = bus_node;
+// Function to grow the buckets of a name index
+static int name_index_grow(struct name_index *index, int new_capacity)
+{
+    struct name_entry **new_buckets = (struct name_entry **)calloc(new_capacity, sizeof(struct name_entry *));
 
-        printf("******** Node successfully created ********\n");                                    // Indicates success of process
+    // Checking for successfull memory allocation
+    if (new_buckets == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
     }
-    else if (!(strcmp(type, "Organisation")))
+
+    unsigned int mask = new_capacity - 1;
+
+    // Moving the chains over. Each chain is walked from it's tail end so that the newest node stays in front
+    for (int i = 0; i < index->capacity; i++)
     {
-        struct organisation *org_node = (struct organisation *)malloc(sizeof(struct organisation));
+        struct name_entry *reversed = NULL;
+        struct name_entry *curr = index->buckets[i];
 
-        // Checking if allocation was successful
-        if (org_node == NULL)
+        while (curr != NULL)
         {
-            printf("Memory allocation failed. Please try again\n");
+            struct name_entry *next = curr->next;
+            curr->next = reversed;
+            reversed = curr;
+            curr = next;
         }
 
-        // Setting the type to organisation
-        strcpy(org_node->type, "Organisation");
+        while (reversed != NULL)
+        {
+            struct name_entry *next = reversed->next;
+            unsigned int pos = reversed->hash & mask;
 
-        // Taking inputs for the common attributes
+            reversed->next = new_buckets[pos];
+            new_buckets[pos] = reversed;
+            reversed = next;
+        }
+    }
 
-        printf("\nEnter the ID of the Organisation\n");
-        scanf("%d%c", &(org_node->id), &throwaway);
+    free(index->buckets);
 
-        printf("Enter the name of the organisation\n");
-        org_node->name = name_input("Organisation");
+    index->buckets = new_buckets;
+    index->capacity = new_capacity;
 
-        printf("Enter the creation date of the organisation\n");
-        org_node->creation = date_input();
+    return 1;
+}
 
-        printf("Enter the content of the organisation\n");
-        org_node->content = content_input("Organisation");
+// Function to make sure the name index of a kind can hold count nodes without growing
+int name_index_reserve(enum node_kind kind, int count)
+{
+    struct name_index *index = &all_Names[kind];
+    int capacity = index->capacity ? index->capacity : 16;
 
-        // Inputs for the unique attributes
+    while (capacity < count)
+        capacity *= 2;
 
-        printf("\nEnter the X Co-ordinate\n");
-        scanf("%lf%c", &(org_node->x_cord), &throwaway);
+    if (capacity > index->capacity)
+        return name_index_grow(index, capacity);
 
-        printf("Enter the Y Co-ordinate\n");
-        scanf("%lf%c", &(org_node->y_cord), &throwaway);
+    return 1;
+}
 
-        // Intializing the members list to NULL
-        org_node->orgmember_head = NULL;
+// Function to add a node to the name index
+int name_index_insert(enum node_kind kind, char *name, void *node)
+{
+    struct name_index *index = &all_Names[kind];
 
-        char check;                                                             // Used to check for inputs from the user regarding members
+    if (pending_indexes & INDEX_NAMES)
+        return 1; // The node is added along with the rest once the index is built
 
-        printf("Do you want to enter any member(s) (Y/N)\n");                   // Taking input from the user
-        scanf("%c%c", &check, &throwaway);
+    // Keeping atmost one entry per bucket on average
+    if (index->count >= index->capacity && !name_index_grow(index, index->capacity ? index->capacity * 2 : 16))
+        return 0;
 
-        while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')    // Iterating till a correct answer has been given
-        {
-            printf("Error!! Please enter the correct characer (Y/N)\n");
-            scanf("%c%c", &check, &throwaway);
-        }
+    struct name_entry *entry = (struct name_entry *)malloc(sizeof(struct name_entry));
 
-        if (check == 'Y' || check == 'y')                                       // If the user inputs yes
-        {
-            while (check == 'Y' || check == 'y')                                // Loop to add more members
-            {
-                printf("Enter the name of member\n");
+    if (entry == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
+    }
 
-                char *member_name = name_input();
+    entry->hash = name_hash(name);
+    entry->name = name;
+    entry->node = node;
 
-                struct individual *temp_ind = (struct individual *)search_to_link(member_name, "Individual");
+    // Adding to the front of the chain, so that the newest node with a name is found first
+    unsigned int pos = entry->hash & (index->capacity - 1);
+    entry->next = index->buckets[pos];
+    index->buckets[pos] = entry;
 
-                if (temp_ind == NULL)
-                    printf("Such a name doesn't exist\n");
-                else
-                {
-                    // Allocating memoruy for a new member
-                    struct linked_individual *new_member = (struct linked_individual *)malloc(sizeof(struct linked_individual));
+    index->count++;
 
-                    // Assigning the organisation as a back pointer to the individual
-                    struct linked_organisation *org_back = (struct linked_organisation *)malloc(sizeof(struct linked_organisation));
-                    org_back->node_org = org_node;
-                    org_back->next = temp_ind->back_org;
-                    temp_ind->back_org = org_back;
+    return 1;
+}
 
-                    // Now assiging the indivudal to the organisation
-                    new_member->node_ind = temp_ind;
-                    new_member->next = org_node->orgmember_head;
-                    org_node->orgmember_head = new_member;
+// Function to reverse the order of the entries in every chain of a name index
+static void name_index_reverse(enum node_kind kind)
+{
+    struct name_index *index = &all_Names[kind];
 
-                    printf("Successfully added!!\n");
-                }
+    for (int i = 0; i < index->capacity; i++)
+    {
+        struct name_entry *reversed = NULL;
 
-                printf(" Do you want to enter any other names??\n");                        // Asking for any more individuals
-                scanf("%c%c", &check, &throwaway);
+        while (index->buckets[i] != NULL)
+        {
+            struct name_entry *entry = index->buckets[i];
 
-                while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')        // Iterating till correct answer given
-                {
-                    printf("Error!! Please enter the correct characer (Y/N)\n");
-                    scanf("%c%c", &check, &throwaway);
-                }
-            }
+            index->buckets[i] = entry->next;
+            entry->next = reversed;
+            reversed = entry;
         }
 
-        // Linking the created node to the global list
-
-        org_node->next = all_Organisation;
-        all_Organisation = org_node;
-
-        printf("******** Node successfully created ********\n");                            // Successfully created!!!
+        index->buckets[i] = reversed;
     }
-    else if (!(strcmp(type, "Group")))
-    {
-        // Allocating memory for a new node
-        struct group *grp_node = (struct group *)malloc(sizeof(struct group));
-
-        // Checking if allocation was successful
-        if (grp_node == NULL)
-        {
-            printf("Memory allocation failed. Please try again\n");
-        }
+}
 
-        // Setting the type to group
-        strcpy(grp_node->type, "Group");
+// Function to find the next entry with a given name starting from a given entry
+static struct name_entry *name_chain_match(struct name_entry *entry, unsigned int hash, char *name)
+{
+    while (entry != NULL && (entry->hash != hash || strcmp(entry->name, name)))
+        entry = entry->next;
 
-        // Taking inputs for the common attributes
+    return entry;
+}
 
-        printf("\nEnter the ID of the Group\n");
-        scanf("%d%c", &(grp_node->id), &throwaway);
+// Function to find the first node with a given name
+struct name_entry *name_index_find(enum node_kind kind, char *name)
+{
+    struct name_index *index = &all_Names[kind];
 
-        printf("Enter the name of the group\n");
-        grp_node->name = name_input("Group");
+    if ((pending_indexes & INDEX_NAMES) && !index_require(INDEX_NAMES))
+        return NULL;
 
-        printf("Enter the creation date of the group\n");
-        grp_node->creation = date_input();
+    if (index->count == 0)
+        return NULL;
 
-        printf("Enter the content of the group");
-        grp_node->content = content_input("Group");
+    unsigned int hash = name_hash(name);
 
-        // Inputs for the unique attributes
+    return name_chain_match(index->buckets[hash & (index->capacity - 1)], hash, name);
+}
 
-        printf("\nEnter the X Co-ordinate\n");
-        scanf("%lf%c", &(grp_node->x_cord), &throwaway);
+// Function to find the next node with the same name
+struct name_entry *name_index_next(struct name_entry *entry)
+{
+    return name_chain_match(entry->next, entry->hash, entry->name);
+}
 
-        printf("Enter the Y Co-ordinate\n");
-        scanf("%lf%c", &(grp_node->y_cord), &throwaway);
+// Function to remove a node from the name index
+void name_index_remove(enum node_kind kind, char *name, void *node)
+{
+    struct name_index *index = &all_Names[kind];
 
-        // Initializing the members lists to NULL
-        grp_node->businessmember_head = NULL;
-        grp_node->grpmember_head = NULL;
+    if (index->count == 0)
+        return;
 
-        char check;
+    unsigned int pos = name_hash(name) & (index->capacity - 1);
 
-        printf("Do you want to enter any individual member(s) (Y/N)\n");            // Asking if there are any individual members
-        scanf("%c%c", &check, &throwaway);
+    struct name_entry *curr = index->buckets[pos];
+    struct name_entry *prev = NULL;
 
-        while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')        // Iterating till a correct answer is given
+    while (curr != NULL)
+    {
+        if (curr->node == node) // Matching the node itself, as other nodes may have the same name
         {
-            printf("Error!! Please enter the correct characer (Y/N)\n");
-            scanf("%c%c", &check, &throwaway);
-        }
+            if (prev == NULL)
+                index->buckets[pos] = curr->next;
+            else
+                prev->next = curr->next;
 
-        if (check == 'Y' || check == 'y')                                           // If the user inputs yes
-        {   
-            while (check == 'Y' || check == 'y')                                    // Loop to add more members
-            {
-                printf("Enter the name of individual member\n");                    
+            free(curr);
+            index->count--;
 
-                char *member_name = name_input();
+            return;
+        }
 
-                struct individual *temp_ind = (struct individual *)search_to_link(member_name, "Individual");
+        prev = curr;
+        curr = curr->next;
+    }
+}
 
-                if (temp_ind == NULL)
-                    printf("Such a name doesn't exist\n");
-                else
-                {
-                    // Alloating memory for a new node
-                    struct linked_individual *new_member = (struct linked_individual *)malloc(sizeof(struct linked_individual));
+// Function to point the entry of a node in the name index to the node's new address
+void name_index_move(enum node_kind kind, char *name, void *from, void *to)
+{
+    struct name_index *index = &all_Names[kind];
 
-                    // Assigning this group as a back pointer to the individual
-                    struct linked_group *grp_back = (struct linked_group *)malloc(sizeof(struct linked_group));
-                    grp_back->node_grp = grp_node;
-                    grp_back->next = temp_ind->back_grp;
-                    temp_ind->back_grp = grp_back;
+    if (index->count == 0)
+        return;
 
-                    // Now assiging the individual node to the group
-                    new_member->node_ind = temp_ind;
-                    new_member->next = grp_node->grpmember_head;
-                    grp_node->grpmember_head = new_member;
+    for (struct name_entry *curr = index->buckets[name_hash(name) & (index->capacity - 1)]; curr != NULL; curr = curr->next)
+    {
+        if (curr->node == from)
+        {
+            curr->node = to;
+            return;
+        }
+    }
+}
 
-                    printf("Successfully added!!\n");
-                }
+// Function to read the next word of a text into word, lowercased and cut to WORD_LIMIT characters.
+// Returns the position right after the word, or NULL if there are no more words
+char *next_word(char *text, char word[])
+{
+    while (*text != '\0' && !isalnum((unsigned char)*text))
+        text++;
 
-                printf("Do you want to enter any other names (Y/N) ??\n");                      // Checking if there are any more nodes
-                scanf("%c%c", &check, &throwaway);
+    if (*text == '\0')
+        return NULL;
 
-                while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')            // Iterating till correct answer is given
-                {   
-                    printf("Error!! Please enter the correct characer (Y/N)\n");
-                    scanf("%c%c", &check, &throwaway);
-                }
-            }
-        }
+    int length = 0;
 
-        printf("\nDo you want to enter any business member(s) (Y/N)\n");                        // ASKing for any business members
-        scanf("%c%c", &check, &throwaway);
+    while (isalnum((unsigned char)*text))
+    {
+        if (length < WORD_LIMIT)
+            word[length++] = (char)tolower((unsigned char)*text);
 
-        while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')                    // Iterating till a correct character is given
-        {
-            printf("Error!! Please enter the correct characer (Y/N)\n");
-            scanf("%c%c", &check, &throwaway);
-        }
+        text++;
+    }
 
-        if (check == 'Y' || check == 'y')                                                       // If the user inputs yes
-        {
-            while (check == 'Y' || check == 'y')                                                // Loop to add more businesses
-            {
-                printf("Enter the name of member\n");
+    word[length] = '\0';
 
-                char *member_name = name_input();
+    return text;
+}
 
-                struct business *temp_bus = (struct business *)search_to_link(member_name, "Business");
+// Function to find the entry of a word in a word index
+static struct word_entry *word_index_find(struct word_index *index, char *word)
+{
+    if (index->count == 0)
+        return NULL;
 
-                if (temp_bus == NULL)
-                    printf("Such a name doesn't exist\n");
-                else
-                {
-                    // Allocating memory for a new node
-                    struct linked_business *new_member = (struct linked_business *)malloc(sizeof(struct linked_business));
+    unsigned int hash = name_hash(word);
+    struct word_entry *entry = index->buckets[hash & (index->capacity - 1)];
 
-                    // Assigning this group as a back pointer
-                    struct linked_group *grp_back = (struct linked_group *)malloc(sizeof(struct linked_group));
-                    grp_back->node_grp = grp_node;
-                    grp_back->next = temp_bus->back_grp;
-                    temp_bus->back_grp = grp_back;
+    while (entry != NULL && (entry->hash != hash || strcmp(entry->word, word)))
+        entry = entry->next;
 
-                    // Now assiging the business node to the group
-                    new_member->node_bus = temp_bus;
-                    new_member->next = grp_node->businessmember_head;
-                    grp_node->businessmember_head = new_member;
+    return entry;
+}
 
-                    printf("Successfully added!!\n");
-                }
+// Function to grow the buckets of a word index
+static int word_index_grow(struct word_index *index, int new_capacity)
+{
+    struct word_entry **new_buckets = (struct word_entry **)calloc(new_capacity, sizeof(struct word_entry *));
 
-                printf("Do you want to enter any other names (Y/N) ??\n");                      // ASKing if there are any more business members
-                scanf("%c%c", &check, &throwaway);
+    // Checking for successfull memory allocation
+    if (new_buckets == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return 0;
+    }
 
-                while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')            // Iterating till a correct character is given
-                {
-                    printf("Error!! Please enter the correct characer (Y/N)\n");
-                    scanf("%c%c", &check, &throwaway);
-                }
-            }
-        }
+    for (int i = 0; i < index->capacity; i++)
+    {
+        struct word_entry *curr = index->buckets[i];
 
-        // Adding this group node to the global list
-        grp_node->next = all_Group;
-        all_Group = grp_node;
+        while (curr != NULL)
+        {
+            struct word_entry *next = curr->next;
+            unsigned int pos = curr->hash & (new_capacity - 1);
 
-        printf("******** Node successfully created ********\n");
+            curr->next = new_buckets[pos];
+            new_buckets[pos] = curr;
+            curr = next;
+        }
     }
+
+    free(index->buckets);
+
+    index->buckets = new_buckets;
+    index->capacity = new_capacity;
+
+    return 1;
 }
 
-// Function to print one-hop nodes
-void one_hop(int id)
+// Function to find the position of an id in a posting list, or where it would have to be inserted
+static int posting_position(struct word_entry *entry, int id)
 {
+    int low = 0, high = entry->count;
 
-    int flag = 1;
+    // Nodes are mostly created in increasing order of id, so the end of the list is checked first
+    if (high > 0 && entry->ids[high - 1] < id)
+        return high;
+
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
 
-    // Temporary iterators(pointers) to traverse the global lists
+        if (entry->ids[mid] < id)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
 
-    struct individual *all_ind = all_Individuals;
-    struct business *all_bus = all_business;
-    struct organisation *all_org = all_Organisation;
-    struct group *all_grp = all_Group;
+// Function to add a node to the posting list of a word
+static int word_index_insert(struct word_index *index, char *word, int id)
+{
+    struct word_entry *entry = word_index_find(index, word);
 
-    while (all_ind != NULL && flag)                                                     // Traversing the global list
+    if (entry == NULL)
     {
-        if (all_ind->id == id)                                                  // Checking for a match of id
+        // Keeping atmost one entry per bucket on average
+        if (index->count >= index->capacity && !word_index_grow(index, index->capacity ? index->capacity * 2 : 64))
+            return 0;
+
+        entry = (struct word_entry *)calloc(1, sizeof(struct word_entry));
+
+        if (entry == NULL || (entry->word = (char *)malloc(strlen(word) + 1)) == NULL)
         {
-            struct individual *temp_ind = (struct individual *)all_ind;         // A match is found in individual so temporary pointer is pointed to it
+            free(entry);
+            printf("Memory allocation failed. Please try again\n");
+            return 0;
+        }
 
-            // Temporary iterators to the back pointers
-            struct linked_business *bus_type = temp_ind->back_bus;
-            struct linked_organisation *org_type = temp_ind->back_org;
-            struct linked_group *grp_type = temp_ind->back_grp;
+        strcpy(entry->word, word);
+        entry->hash = name_hash(word);
 
-            while (bus_type != NULL || org_type != NULL || grp_type != NULL)        // Runs till all the back pinters become null
-            {
+        unsigned int pos = entry->hash & (index->capacity - 1);
+        entry->next = index->buckets[pos];
+        index->buckets[pos] = entry;
 
-                if (flag)                                                           // Runs if tehre is atleast one back node
-                {
-                    printf("The 1-hop nodes are:- \n\n");
-                    flag = 0;
-                }
+        index->count++;
+    }
 
-                while (bus_type != NULL)                                            // Printing all the businesses the individual is a part of
-                {
-                    print_node(bus_type->node_bus, "Business");
-                    bus_type = bus_type->next;
-                }
+    int pos = posting_position(entry, id);
 
-                while (org_type != NULL)
-                {
-                    print_node(org_type->node_org, "Organisation");                 // Printing all the oragnisations the individual is a part of
-                    org_type = org_type->next;
-                }
+    if (pos < entry->count && entry->ids[pos] == id)
+        return 1; // The node already uses the word
 
-                while (grp_type != NULL)
-                {
-                    print_node(grp_type->node_grp, "Group");                        // Printing all the groups the individual is a part of
-                    grp_type = grp_type->next;
-                }
-            }
+    if (entry->count == entry->capacity)
+    {
+        int new_capacity = entry->capacity ? entry->capacity * 2 : 4;
+        int *temp = (int *)realloc(entry->ids, new_capacity * sizeof(int));
+
+        if (temp == NULL)
+        {
+            printf("Memory allocation failed. Please try again\n");
+            return 0;
         }
 
-        all_ind = all_ind->next;                                                    // Moving on to the next individual
+        entry->ids = temp;
+        entry->capacity = new_capacity;
     }
-    while (all_bus != NULL && flag)                                                     // Traversing the global list
-    {
-        if (all_bus->id == id)                                                  // A match is found
-        {
-            struct business *temp = (struct business *)all_bus;                 // A temporary pointer created to point to the found business node
 
-            // Temporary iterators for the back pointers
-            struct linked_group *grp_type = temp->back_grp;                 
+    // Keeping the list sorted, so that lists can be intersected by merging
+    memmove(entry->ids + pos + 1, entry->ids + pos, (entry->count - pos) * sizeof(int));
+    entry->ids[pos] = id;
+    entry->count++;
 
-            while (grp_type != NULL)                                            
-            {
+    return 1;
+}
 
-                if (flag)
-                {
-                    printf("The 1-hop nodes are:- \n\n");
-                    flag = 0;
-                }
+// Function to remove a node from the posting list of a word
+static void word_index_erase(struct word_index *index, char *word, int id)
+{
+    struct word_entry *entry = word_index_find(index, word);
 
-                while (grp_type != NULL)
-                {
-                    print_node(grp_type->node_grp, "Group");                      // Printing all the groups the business is a part of
-                    grp_type = grp_type->next;
-                }
-            }
+    if (entry == NULL)
+        return;
 
-            // Printing the owners and customers
+    int pos = posting_position(entry, id);
 
-            // Creating temporary iterators for owners and customers
-            struct linked_individual *temp_owners = temp->owners;
-            struct linked_individual *temp_customers = temp->customers;
+    if (pos == entry->count || entry->ids[pos] != id)
+        return; // Already removed, the word was used more than once
 
-            while (temp_owners != NULL || temp_customers != NULL)                   // Runs till there are no more owners and customers left
-            {
+    memmove(entry->ids + pos, entry->ids + pos + 1, (entry->count - pos - 1) * sizeof(int));
+    entry->count--;
 
-                if (flag)
-                {
-                    printf("The 1-hope nodes are:- \n\n");
-                    flag = 0;
-                }
+    if (entry->count > 0)
+        return;
 
-                while (temp_owners != NULL)
-                {
-                    print_node(temp_owners->node_ind, "Individual");                // Printing all the owners of the business
-                    temp_owners = temp_owners->next;
-                }
+    // No node uses the word any more
+    struct word_entry **link = &index->buckets[entry->hash & (index->capacity - 1)];
 
-                while (temp_customers != NULL)
-                {
-                    print_node(temp_customers->node_ind, "Individual");             // Printing all the customers of the business
-                    temp_customers = temp_customers->next;
-                }
-            }
-        }
+    while (*link != entry)
+        link = &(*link)->next;
 
-        all_bus = all_bus->next;                                                    // Moving to the new 
-    }
-    while (all_org != NULL && flag)                                                     // Traversing the global list only if a match hasnt been found previously
+    *link = entry->next;
+
+    free(entry->word);
+    free(entry->ids);
+    free(entry);
+
+    index->count--;
+}
+
+// Function to take every entry out of a word index, leaving it's buckets for the entries added next
+static void word_index_clear(struct word_index *index)
+{
+    for (int i = 0; i < index->capacity; i++)
     {
-        if (all_org->id == id)                                                          // match has been found
+        while (index->buckets[i] != NULL)
         {
+            struct word_entry *entry = index->buckets[i];
+            index->buckets[i] = entry->next;
 
-            struct organisation *temp = (struct organisation *)all_org;                 // Temporary pointer to the matched group
+            free(entry->word);
+            free(entry->ids);
+            free(entry);
+        }
+    }
 
-            struct linked_individual *temp_members = temp->orgmember_head;
+    index->count = 0;
+}
 
-            while (temp_members != NULL)                                                // Printing all the individual members of the group
-            {
+// Function to add the words of a text to the word index
+int word_index_add(int id, char *text)
+{
+    char word[WORD_LIMIT + 1];
 
-                if (flag)
-                {
-                    printf("The 1-hop nodes are:- \n\n");
-                    flag = 0;
-                }
+    if (pending_indexes & INDEX_WORDS)
+        return 1; // The text is added along with the rest once the index is built
 
-                while (temp_members != NULL)
-                {
-                    print_node(temp_members->node_ind, "Individual");
+    while ((text = next_word(text, word)) != NULL)
+    {
+        if (!word_index_insert(&all_Words, word, id))
+            return 0;
+    }
 
-                    temp_members = temp_members->next;
-                }
-            }
-        }
+    return 1;
+}
 
-        all_org = all_org->next;                                                          // Traversing the global list 
-    }
-    while (all_grp != NULL && flag)                                                     // Traversing over groups if a match hasn't been found earlier
-    {
-        if (all_grp->id == id)                                                          // Match has been found
-        {
-            struct group *temp = (struct group *)all_grp;                               // Temporary pointer to the matched group
+// Function to remove a node from the posting lists of all the words of a text
+void word_index_remove(int id, char *text)
+{
+    char word[WORD_LIMIT + 1];
 
-            struct linked_individual *ind_members = temp->grpmember_head;
-            struct linked_business *bus_members = temp->businessmember_head;
+    if (pending_indexes & INDEX_WORDS)
+        return;
 
-            while (ind_members != NULL || bus_members != NULL)                          // Runs till there are no more individual and business memebers left to be printed
-            {
+    while ((text = next_word(text, word)) != NULL)
+        word_index_erase(&all_Words, word, id);
+}
 
-                if (flag)
-                {
-                    printf("The 1-hop nodes are:- \n\n");
-                    flag = 0;
-                }
+// Function to add the trigrams of a text to the trigram index
+int trigram_index_add(int id, char *text)
+{
+    char trigram[4] = {0};
 
-                while (ind_members != NULL)
-                {
-                    print_node(ind_members->node_ind, "Individual");                    // Printing all the individual members
-                    ind_members = ind_members->next;
-                }
+    if (pending_indexes & INDEX_WORDS)
+        return 1;
 
-                while (bus_members != NULL)
-                {
-                    print_node(bus_members->node_bus, "Business");                      // Printing all the business members
-                    bus_members = bus_members->next;
-                }
-            }
-        }
+    for (; text[0] != '\0' && text[1] != '\0' && text[2] != '\0'; text++)
+    {
+        memcpy(trigram, text, 3);
 
-        all_grp = all_grp->next;                                                        // Iterating over the global list
+        if (!word_index_insert(&all_Trigrams, trigram, id))
+            return 0;
     }
 
-    if (flag)
-        printf("There are no 1-hop nodes\n");                                           // Case to chekc if there was no match or no 1-hop nodes
+    return 1;
 }
 
-// Function to swap two 2-hop nodes
-void swap_nodes(struct individual_hop *node_1, struct individual_hop *node_2)
+// Function to remove a node from the posting lists of all the trigrams of a text
+void trigram_index_remove(int id, char *text)
 {
-    struct linked_individual *temp = node_1->lnkd_ind_node;                     // Temporary pinter to store the would be changed value
-    node_1->lnkd_ind_node = node_2->lnkd_ind_node;                              // Just changing the individual they are linked to
-    node_2->lnkd_ind_node = temp;
+    char trigram[4] = {0};
+
+    if (pending_indexes & INDEX_WORDS)
+        return;
+
+    for (; text[0] != '\0' && text[1] != '\0' && text[2] != '\0'; text++)
+    {
+        memcpy(trigram, text, 3);
+        word_index_erase(&all_Trigrams, trigram, id);
+    }
 }
 
-// Function to print two-hop nodes for a given INdividual node
-void two_hop(struct individual *node)
+// Function to read the coordinates of a node, returns 0 for an individual which has none
+static int node_position(void *node, double *x, double *y)
 {
-    // Temporary iterators to the back pointers of the given node
-    struct linked_organisation *temp_org = node->back_org;
-    struct linked_group *temp_grp = node->back_grp;
+    switch (NODE_KIND(node))
+    {
+        case NODE_BUSINESS:
+            *x = ((struct business *)node)->x_cord;
+            *y = ((struct business *)node)->y_cord;
+            return 1;
+
+        case NODE_ORGANISATION:
+            *x = ((struct organisation *)node)->x_cord;
+            *y = ((struct organisation *)node)->y_cord;
+            return 1;
+
+        case NODE_GROUP:
+            *x = ((struct group *)node)->x_cord;
+            *y = ((struct group *)node)->y_cord;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
 
-    int flag = 1;
+// Function to read the coordinate a level of the k-d tree splits on, x at even depths and y at odd ones
+static double place_coordinate(struct place *place, int depth)
+{
+    return (depth & 1) ? place->y : place->x;
+}
+
+// Function to add a node to the spatial index of it's kind, it stays outside the tree till the next rebuild
+int spatial_index_insert(void *node)
+{
+    struct place place;
+
+    if ((pending_indexes & INDEX_PLACES) || !node_position(node, &place.x, &place.y))
+        return 1; // Left for when the index is built, or an individual which has no coordinates
 
-    // Iterators for the list of 2-hop individuals
-    struct individual_hop *head = NULL;
+    struct spatial_index *index = &all_Places[NODE_KIND(node)];
 
-    while (temp_org != NULL)
+    if (index->count == index->capacity)
     {
-        // Temporary iterator of linked_individual type to iterate over the individual nodes
-        struct linked_individual *temp_ind = temp_org->node_org->orgmember_head;
+        int new_capacity = index->capacity ? index->capacity * 2 : 64;
+        struct place *temp = (struct place *)realloc(index->places, new_capacity * sizeof(struct place));
 
-        // Adding the individuals from the organisation member list
-        while (temp_ind != NULL)
+        if (temp == NULL)
         {
-            if (node->id == temp_ind->node_ind->id)                                 // Skipping if the node is the original node we are pritning for
-            {
-                temp_ind = temp_ind->next;
-                continue;
-            }
-
-            struct individual_hop *curr = (struct individual_hop *)malloc(sizeof(struct individual_hop));    // Else creating a node to store the individual member present in it
+            printf("Memory allocation failed. Please try again\n");
+            return 0;
+        }
 
-            // Poiting the created node to the current individual member being examined
-            curr->lnkd_ind_node = temp_ind;                                                                 
-            curr->next = NULL;
+        index->places = temp;
+        index->capacity = new_capacity;
+    }
 
-            struct individual_hop *temp = head;                                         // Pointer to the head of the two-hop members list
-            int check = 1;  
+    place.id = NODE_ID(node);
+    place.removed = 0;
 
-            while (temp != NULL)
-            {
-                if (temp->lnkd_ind_node->node_ind->id == curr->lnkd_ind_node->node_ind->id)     // Checking it the currrent individual exmained is already present in the two-hop lsit
-                {
-                    check = 0;                                                                  // If it is , skipping over it
-                    free(curr);                                                                 // Freeing the memory sued as it container
-                    break;      
-                }
+    index->places[index->count++] = place;
 
-                temp = temp->next;
-            }
+    return 1;
+}
 
-            if (check)
-            {
-                if (flag)
-                {
-                    head = curr;                                                                 // If this is the frist wo - hop node, it becomes the head
-                    flag = 0;
-                }
-                else
-                {   
-                    curr->next = head;                                                          // Adding the ndoe to the two-hop list
-                    head = curr;
-                }
-            }
+// Function to find and mark a place in the tree part of an index as removed
+static int spatial_tree_remove(struct spatial_index *index, int low, int high, int depth, struct place *target)
+{
+    if (low >= high)
+        return 0;
 
-            temp_ind = temp_ind->next;
-        }
+    int mid = low + (high - low) / 2;
+    struct place *place = &index->places[mid];
 
-        temp_org = temp_org->next;
+    if (!place->removed && place->id == target->id)
+    {
+        place->removed = 1;
+        index->removed++;
+        return 1;
     }
 
-    while (temp_grp != NULL)
-    {
-        // Temporary iterator of linked_individual type to iterate over the individual nodes
-        struct linked_individual *temp_ind = temp_grp->node_grp->grpmember_head;
+    double split = place_coordinate(place, depth);
+    double coordinate = place_coordinate(target, depth);
+
+    // A place with the same coordinate as the split can be on either side
+    return (coordinate <= split && spatial_tree_remove(index, low, mid, depth + 1, target)) ||
+           (coordinate >= split && spatial_tree_remove(index, mid + 1, high, depth + 1, target));
+}
+
+// Function to remove a node from the spatial index of it's kind
+void spatial_index_remove(void *node)
+{
+    struct place target;
 
-        // Adding the individuals from the group member list
-        while (temp_ind != NULL)
+    if (!node_position(node, &target.x, &target.y))
+        return;
+
+    struct spatial_index *index = &all_Places[NODE_KIND(node)];
+
+    target.id = NODE_ID(node);
+
+    // The places added since the last rebuild are checked first, as they aren't sorted
+    for (int i = index->tree_count; i < index->count; i++)
+    {
+        if (index->places[i].id == target.id)
         {
-            if (node->id == temp_ind->node_ind->id)
-            {
-                temp_ind = temp_ind->next;
-                continue;
-            }
+            index->places[i] = index->places[--index->count];
+            return;
+        }
+    }
 
-            struct individual_hop *curr = (struct individual_hop *)malloc(sizeof(struct individual_hop));   // Creating a containeer node which pints to the current individual being examined
+    spatial_tree_remove(index, 0, index->tree_count, 0, &target);
+}
 
-            curr->lnkd_ind_node = temp_ind;
-            curr->next = NULL;
+// Function to partially sort places[low] to places[high - 1] so that the middle one is where it would be if they
+// were sorted on the coordinate of the depth, with smaller or equal coordinates before it and bigger or equal after it
+static void spatial_select(struct place *places, int low, int high, int depth)
+{
+    int mid = low + (high - low) / 2;
 
-            struct individual_hop *temp = head;                                         // Pointer to the head of the two-hop members list
-            int check = 1;
+    high--;
 
-            while (temp != NULL)
-            {
-                if (temp->lnkd_ind_node->node_ind->id == curr->lnkd_ind_node->node_ind->id)         // If the current individual ndoe is already present, skip over it
-                {
-                    check = 0;
-                    free(curr);                                                                     // Free memory allocated for the container
-                    break;  
-                }
+    while (low < high)
+    {
+        // Median of the ends and the middle as the pivot
+        struct place temp;
+        double a = place_coordinate(&places[low], depth), b = place_coordinate(&places[mid], depth), c = place_coordinate(&places[high], depth);
+        double pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a)) : ((a < c) ? a : (b < c ? c : b));
 
-                temp = temp->next;
-            }
+        int i = low, j = high;
+
+        while (i <= j)
+        {
+            while (place_coordinate(&places[i], depth) < pivot)
+                i++;
+            while (place_coordinate(&places[j], depth) > pivot)
+                j--;
 
-            if (check)
+            if (i <= j)
             {
-                if (flag)
-                {
-                    head = curr;                                                                    // If the given node is the first two-hop member, it becomes the head
-                    flag = 0;
-                }
-                else
-                {   
-                    curr->next = head;                                                          // Adding the current individual to the two-hop members list
-                    head = curr;
-                }
+                temp = places[i];
+                places[i] = places[j];
+                places[j] = temp;
+                i++;
+                j--;
             }
-
-            temp_ind = temp_ind->next;
         }
 
-        temp_grp = temp_grp->next;                                                               // Moving onto the next group
+        // places[low..j] <= pivot <= places[i..high], and anything between the two is equal to the pivot
+        if (mid <= j)
+            high = j;
+        else if (mid >= i)
+            low = i;
+        else
+            break;
     }
+}
 
-    // Checking if there are any two-hop nodes
-    if (flag)
+// Function to build the k-d tree over places[low] to places[high - 1]
+static void spatial_build(struct place *places, int low, int high, int depth)
+{
+    while (high - low > 1)
     {
-        printf("There are no two-hop nodes\n"); 
-        return;
+        int mid = low + (high - low) / 2;
+
+        spatial_select(places, low, high, depth);
+        spatial_build(places, low, mid, depth + 1);
+
+        low = mid + 1;
+        depth++;
     }
+}
 
-    // Printing the nodes now
-    printf("The two-hop nodes are:-\n\n");
+// Function to rebuild the tree of a spatial index if too many places were added or removed since it was built
+static void spatial_index_refresh(struct spatial_index *index)
+{
+    int outside = index->count - index->tree_count;
 
-    struct individual_hop *curr = head;
-    struct individual_hop *prev = NULL;
+    if (outside <= 16 + index->tree_count / 8 && index->removed <= index->tree_count / 4)
+        return;
 
-    while (curr != NULL)
-    {
+    // Dropping the removed places
+    int kept = 0;
 
-        printf("Name :- %s\n", curr->lnkd_ind_node->node_ind->name);                            // Printing the name and
-        printf("Content:- \n%s\n", curr->lnkd_ind_node->node_ind->content);                     // content of all the two hop nodes
+    for (int i = 0; i < index->count; i++)
+        if (!index->places[i].removed)
+            index->places[kept++] = index->places[i];
 
-        prev = curr;
-        curr = curr->next;
-        free(prev);                                                                             // Freeing the nodes once we have printed their contents
-    }
+    index->count = kept;
+    index->tree_count = kept;
+    index->removed = 0;
+
+    spatial_build(index->places, 0, kept, 0);
 }
 
-// Function to add content to already existing content
-void add_content()
+// Function to compare two places found by their distance, and then by id
+static int compare_place_hits(const void *a, const void *b)
 {
-    printf("\nEnter the ID of the node you want to modify: ");
-    int id;
-    scanf("%d%c", &id, &throwaway);
+    const struct place_hit *x = (const struct place_hit *)a;
+    const struct place_hit *y = (const struct place_hit *)b;
 
-    printf("\nEnter the content you want to add\n");
-    char *new_content = content_input();
-
-    if (new_content == NULL)
-    {
-        printf("Memory allocation failed. Please try again\n");
-        return;
-    }
+    if (x->distance != y->distance)
+        return (x->distance > y->distance) - (x->distance < y->distance);
 
-    char *node_content;
-    int flag = 1;
+    return (x->id > y->id) - (x->id < y->id);
+}
 
-    // Temporary iterators (pointers) to traverse the global lists
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+// Function to add a place to the places found, keeping the ones nearest to the point when only count are wanted
+static int spatial_report(struct place *place, double distance, int limit)
+{
+    struct place_hit hit = {place->id, distance};
 
-    // Iterating over the entire nodes to find a match with the given (unique)id
-    while (temp_ind != NULL || temp_bus != NULL || temp_org != NULL || temp_grp != NULL)
+    if (limit < 0 || found_places_count < limit)
     {
-        if (temp_ind->id == id)
-        {
-            node_content = temp_ind->content;
-            flag = 0;
-            break;
-        }
-        if (temp_bus->id == id)
+        if (found_places_count == found_places_capacity)
         {
-            node_content = temp_bus->content;
-            flag = 0;
-            break;
+            int new_capacity = found_places_capacity ? found_places_capacity * 2 : 64;
+            struct place_hit *temp = (struct place_hit *)realloc(found_places, new_capacity * sizeof(struct place_hit));
+
+            if (temp == NULL)
+                return 0;
+
+            found_places = temp;
+            found_places_capacity = new_capacity;
         }
-        if (temp_org->id == id)
+
+        int pos = found_places_count++;
+
+        // With a limit the places found are kept as a max-heap on the distance and id, the farthest on top
+        while (limit >= 0 && pos > 0 && compare_place_hits(&found_places[(pos - 1) / 2], &hit) < 0)
         {
-            node_content = temp_org->content;
-            flag = 0;
-            break;
+            found_places[pos] = found_places[(pos - 1) / 2];
+            pos = (pos - 1) / 2;
         }
-        if (temp_grp->id == id)
-        {
-            node_content = temp_grp->content;
-            flag = 0;
+
+        found_places[pos] = hit;
+        return 1;
+    }
+
+    if (limit == 0 || compare_place_hits(&hit, &found_places[0]) >= 0)
+        return 1;
+
+    // Replacing the farthest place found so far
+    int pos = 0;
+
+    while (2 * pos + 1 < found_places_count)
+    {
+        int child = 2 * pos + 1;
+
+        if (child + 1 < found_places_count && compare_place_hits(&found_places[child + 1], &found_places[child]) > 0)
+            child++;
+
+        if (compare_place_hits(&found_places[child], &hit) <= 0)
             break;
-        }
 
-        if (temp_ind != NULL)
-            temp_ind = temp_ind->next;
-        if (temp_bus != NULL)
-            temp_bus = temp_bus->next;
-        if (temp_org != NULL)
-            temp_org = temp_org->next;
-        if (temp_grp != NULL)
-            temp_grp = temp_grp->next;
+        found_places[pos] = found_places[child];
+        pos = child;
     }
 
-    if (flag)
+    found_places[pos] = hit;
+    return 1;
+}
+
+// Function to find the places of an index within a box, or within a radius of a point if radius isn't negative
+static void spatial_search(struct spatial_index *index, int low, int high, int depth, double min[2], double max[2], double point[2], double radius)
+{
+    while (low < high)
     {
-        printf("No such node exists\n");            // No node exists with the given id
+        int mid = low + (high - low) / 2;
+        struct place *place = &index->places[mid];
+        double dx = place->x - point[0], dy = place->y - point[1];
+
+        if (!place->removed && place->x >= min[0] && place->x <= max[0] && place->y >= min[1] && place->y <= max[1] &&
+            (radius < 0 || dx * dx + dy * dy <= radius * radius))
+            spatial_report(place, dx * dx + dy * dy, -1);
+
+        double split = place_coordinate(place, depth);
+
+        // Going into a side only if the box reaches it
+        if (min[depth & 1] <= split)
+            spatial_search(index, low, mid, depth + 1, min, max, point, radius);
+
+        if (max[depth & 1] < split)
+            return;
+
+        low = mid + 1;
+        depth++;
     }
+}
+
+// Function to find the count places of an index nearest to a point
+static void spatial_nearest(struct spatial_index *index, int low, int high, int depth, double point[2], int count, int exclude)
+{
+    if (low >= high)
+        return;
+
+    int mid = low + (high - low) / 2;
+    struct place *place = &index->places[mid];
+    double dx = place->x - point[0], dy = place->y - point[1];
+
+    if (!place->removed && place->id != exclude)
+        spatial_report(place, dx * dx + dy * dy, count);
+
+    // The side of the split with the point first, the other one only if it can have anything nearer than the farthest
+    // place kept so far
+    double gap = point[depth & 1] - place_coordinate(place, depth);
+
+    if (gap <= 0)
+        spatial_nearest(index, low, mid, depth + 1, point, count, exclude);
+    else
+        spatial_nearest(index, mid + 1, high, depth + 1, point, count, exclude);
+
+    if (found_places_count == count && gap * gap > found_places[0].distance)
+        return;
+
+    if (gap <= 0)
+        spatial_nearest(index, mid + 1, high, depth + 1, point, count, exclude);
     else
+        spatial_nearest(index, low, mid, depth + 1, point, count, exclude);
+}
+
+// Function to run a spatial query over the indexes of one kind, or all three kinds with coordinates if kind is -1.
+// A negative radius means the box, a positive count the nearest places
+static int spatial_query(int kind, double min[2], double max[2], double point[2], double radius, int count, int exclude)
+{
+    found_places_count = 0;
+
+    if ((pending_indexes & INDEX_PLACES) && !index_require(INDEX_PLACES))
+        return 0;
+
+    for (int k = NODE_BUSINESS; k <= NODE_GROUP; k++)
     {
-        int old_size = strlen(node_content); // Size of the previous content
-        int new_size = strlen(new_content);  // Size of the content to be added
+        if (kind != -1 && kind != k)
+            continue;
+
+        struct spatial_index *index = &all_Places[k];
 
-        // Checking how much free space is left in the old content string
-        int free_space = ((int)sizeof(node_content) / (int)sizeof(char)) - old_size;
+        spatial_index_refresh(index);
 
-        if (free_space > (new_size + 2))
+        if (count >= 0)
         {
-            // Check if there is enough space to add new content and two '\n' characters
-            if ((old_size + free_space) > (old_size + new_size + 2))
-            {
-                strcat(node_content, "\n\n"); // Adding two '\n' characters
-                strcat(node_content, new_content);
-                printf("\n******** New content successfully added ********\n");
-            }
-            else
+            spatial_nearest(index, 0, index->tree_count, 0, point, count, exclude);
+
+            for (int i = index->tree_count; i < index->count; i++)
             {
-                // Not enough space, allocate new memory and copy old content
-                char *temp = (char *)realloc(node_content, old_size + free_space + new_size + 7); // Adding 7 extra characters for safety
+                double dx = index->places[i].x - point[0], dy = index->places[i].y - point[1];
 
-                if (temp == NULL)
-                    printf("\n********* Error!! Memory allocation failed ********\n");
-                else
-                {
-                    node_content = temp;
-                    strcat(node_content, "\n\n"); // Adding two '\n' characters to differntiate betwwen different contents posted
-                    strcat(node_content, new_content);
-                    printf("\n******** New content successfully added ********\n");
-                }
+                if (index->places[i].id != exclude)
+                    spatial_report(&index->places[i], dx * dx + dy * dy, count);
             }
         }
         else
         {
-            // Not enough free space, allocate new memory
-            node_content = (char *)realloc(node_content, old_size + new_size + 7); // Adding 7 extra characters for safety
+            spatial_search(index, 0, index->tree_count, 0, min, max, point, radius);
 
-            if (node_content == NULL)
-                printf("\n********* Error!! Memory allocation failed ********\n");
-            else
+            // The places outside the tree are checked one by one
+            for (int i = index->tree_count; i < index->count; i++)
             {
-                strcat(node_content, "\n\n"); // Adding two '\n' characters to differentiate between two different contents posted
-                strcat(node_content, new_content);
-                printf("\n******** New content successfully added ********\n");
+                struct place *place = &index->places[i];
+                double dx = place->x - point[0], dy = place->y - point[1];
+
+                if (place->x >= min[0] && place->x <= max[0] && place->y >= min[1] && place->y <= max[1] &&
+                    (radius < 0 || dx * dx + dy * dy <= radius * radius))
+                    spatial_report(place, dx * dx + dy * dy, -1);
             }
         }
     }
 
-    // Free the memory allocated for new_content
-    free(new_content);
+    if (found_places_count > 1)
+        qsort(found_places, found_places_count, sizeof(struct place_hit), compare_place_hits);
+
+    return found_places_count;
 }
 
-// Function to search for and print content
-void search_for_content(char string[])
+// Function to find the places within a radius of a point
+int places_within(int kind, double x, double y, double radius)
 {
-    int flag = 1;
+    double point[2] = {x, y};
+    double min[2] = {x - radius, y - radius};
+    double max[2] = {x + radius, y + radius};
 
-    // Temporary iterators to search
+    if (radius < 0)
+    {
+        found_places_count = 0;
+        return 0;
+    }
 
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+    return spatial_query(kind, min, max, point, radius, -1, 0);
+}
 
-    while (temp_ind != NULL)                            // Iterating over all the individuals                   
-    {   
-        if (strstr(temp_ind->content, string) != NULL)                  // Checking if the given string is a subtsring or not
-        {
-            if (flag)
-            {
-                printf("The node(s) with the given string present in their content are:- \n");
-                flag = 0;
-            }
+// Function to find the places inside a box
+int places_in_box(int kind, double x1, double y1, double x2, double y2)
+{
+    double point[2] = {0, 0};
+    double min[2] = {(x1 < x2) ? x1 : x2, (y1 < y2) ? y1 : y2};
+    double max[2] = {(x1 < x2) ? x2 : x1, (y1 < y2) ? y2 : y1};
 
-            print_node(temp_ind, "Individual");                         //Printing if yes
-        }
+    int count = spatial_query(kind, min, max, point, -1, -1, 0);
+
+    // Ordered by id rather than by the distance to a point
+    for (int i = 0; i < count; i++)
+        found_places[i].distance = 0;
+
+    if (count > 1)
+        qsort(found_places, count, sizeof(struct place_hit), compare_place_hits);
+
+    return count;
+}
+
+// Function to find the places nearest to a point
+int places_nearest(int kind, double x, double y, int count, int exclude)
+{
+    double point[2] = {x, y};
+
+    if (count <= 0)
+    {
+        found_places_count = 0;
+        return 0;
+    }
+
+    return spatial_query(kind, NULL, NULL, point, -1, count, exclude);
+}
 
-        temp_ind = temp_ind->next;
+// Function to take input for a name
+char *name_input()
+{
+
+    int limit = name_limit;
+
+    // Creating the name string
+    char *name = (char *)malloc(name_limit * sizeof(char));
+
+    // Checking for intial memory allocation success
+    if (name == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return NULL;
     }
-    while (temp_bus != NULL)                            // Iterating over all the individuals                    
+
+    int size = 0;
+
+    while (1)
     {
-        if (strstr(temp_bus->content, string) != NULL)                  // Checking if the given string is a subtsring or not                  
+        // Checking array is full and reallocating if necessary
+        if (size == limit)
         {
-            if (flag)
+            limit *= 2;
+            name = (char *)realloc(name, limit * sizeof(char)); // Doubling the previous size
+
+            if (name == NULL)
             {
-                printf("The node(s) with the given string present in their content are:- \n");
-                flag = 0;
+                printf("Memory allocation failed as name too big. PLease try again\n"); // Checking if Memory allocation was successful
+                return NULL;
             }
+        }
+
+        // Taking input from the user
+        char c;
+        scanf("%c", &c);
 
-            print_node(temp_ind, "Business");                         //Printing if yes
+        // If end of the name, terminate.
+        if (c == '\n')
+        {
+            name[size] = '\0'; // Name ends, so finishing the string
+            break;
+        }
+        else
+        {
+            name[size] = c; // Character gets added to the name string
         }
 
-        temp_bus = temp_bus->next;
+        size++;
+    }
+
+    return name; // Pointer(array) to the name is returned
+}
+
+// Function to take input fro a date
+struct tm *date_input()
+{
+    // Creating a new structure
+    struct tm *temp_date = (struct tm *)malloc(sizeof(struct tm));
+
+    // Checking for successfull allocation of memory
+    if (temp_date == NULL)
+    {
+        printf("Memory allocation failed!!. Please try again\n");
+        return NULL;
     }
-    while (temp_org != NULL)                            // Iterating over all the individuals
+
+    // Taking input from the user
+    if (scanf("%d/%d/%d%c", &(temp_date->tm_mday), &(temp_date->tm_mon), &(temp_date->tm_year), &throwaway) != 4)
     {
-        if (strstr(temp_org->content, string) != NULL)                  // Checking if the given string is a subtsring or not
-        {
-            if (flag)
-            {
-                printf("The node(s) with the given string present in their content are:- \n");
-                flag = 0;
-            }
+        // Date entered is of invalid format
+        printf("Invalid date format.\n");
 
-            print_node(temp_org, "Organisation");                         //Printing if yes
-        }
+        temp_date->tm_mday = -1;
+        temp_date->tm_mon = -1;
+        temp_date->tm_year = -1;
+
+        return temp_date;
+    }
+
+    return temp_date; // Returning the pointer of the created date structure
+}
+
+// Function to take the input for content
+char *content_input()
+{
+    // Initialzing a new char pointer(array)
+    char *content = (char *)malloc(content_limit * sizeof(char));
 
-        temp_org = temp_org->next;
+    // Checking for successfull memory allocation
+    if (content == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return NULL;
     }
-    while (temp_grp != NULL)                            // Iterating over all the individuals
+
+    int size = 0;              // Tracks the size of the string
+    int limit = content_limit; // Determines the maximum size of the array
+
+    while (1)
     {
-        if (strstr(temp_grp->content, string) != NULL)                  // Checking if the given string is a subtsring or not
+
+        // Checking array is full and reallocating if necessary
+        if (size == limit)
         {
-            if (flag)
+            limit *= 2;
+            content = (char *)realloc(content, limit * sizeof(char)); // Doubling the array size
+
+            if (content == NULL) // Checking if reallocation was successful
             {
-                printf("The node(s) with the given string present in their content are:- \n");
-                flag = 0;
+                printf("Memory allocation failed as content too big. PLease try again\n");
+                free(content);
+                return NULL;
             }
+        }
+
+        // Taking input from the user
+        char c;
+        scanf("%c", &c);
 
-            print_node(temp_grp, "Group");                         //Printing if yes
+        // If end of the content, terminate.
+        if (c == '\n')
+        {
+            content[size] = '\0';
+            break;
+        }
+        else
+        {
+            content[size] = c;
         }
 
-        temp_grp = temp_grp->next;
+        size++;
     }
 
-    if (flag)
-        printf("There are no matches\n\n");
+    return content; // returning the pointer(array)
 }
 
-// Function to print all nodes
-void print_all()
+// Function to take input for a birthday
+struct tm *birthday_input()
 {
-    int flag = 1;
 
-    // Temporary iterators to search
-
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+    // Taking data from the user
+    printf("Will you input a birthday?? (Y/N)\n");
+    char c;
+    scanf("%c%c", &c, &throwaway);
 
-    while (temp_ind != NULL)                                // Iterating over all the individuals
+    while (c != 'Y' && c != 'y' && c != 'n' && c != 'N')
     {
-        print_node(temp_ind, "Individual");
-
-        if (flag)
-        {
-            printf("\n All the nodes present are:-\n\n");
-            flag = 0;
-        }
-        temp_ind = temp_ind->next;                           // Moving on to the next individual
+        printf("Error!! PLease input either Y (yes) or N (no)\n");
+        scanf("%c%c", &c, &throwaway);
     }
-    while (temp_bus != NULL)                                 // Iterating over all the businesses
+
+    // Take birthday if yes
+    if (c == 'Y' || c == 'y')
     {
-        print_node(temp_bus, "Business");
 
-        if (flag)
-        {
-            printf("\n All the nodes present are:-\n\n");
-            flag = 0;
-        }
-        temp_bus = temp_bus->next;                           // Moving on to the next business
+        printf("Enter your birthday\n");
+        struct tm *temp = date_input();
+        return temp;
     }
-    while (temp_org != NULL)                                // Iterating over all the organisations                            
+    else
     {
-        print_node(temp_org, "Organisation");
 
-        if (flag)
+        struct tm *temp_date = (struct tm *)malloc(sizeof(struct tm));
+
+        // Checking for successfull allocation of memory
+        if (temp_date == NULL)
         {
-            printf("\n All the nodes present are:-\n\n");
-            flag = 0;
+            printf("Memory allocation failed!!. Please try again\n");
+            return NULL;
         }
-        temp_org = temp_org->next;                           // Moving on to the next organisation
+
+        temp_date->tm_mday = -1;
+        temp_date->tm_mon = -1;
+        temp_date->tm_year = -1;
+
+        return temp_date;
     }
-    while (temp_grp != NULL)                                // Iterating over all the groups
+}
+
+// Function to print the attributes of an individual node
+static void print_individual(void *node)
+{
+    struct individual *temp_ind = (struct individual *)node; // Creating a temporary (typecasted) node to work with
+
+    // Printing the attributes
+
+    printf("\nName of the Individual :- %s\n", temp_ind->name);
+    printf("\nID- %d\n", temp_ind->id);
+    printf("\nCreation date :- %d/%d/%d\n", temp_ind->creation->tm_mday, temp_ind->creation->tm_mon, temp_ind->creation->tm_year);
+    printf("145\n");
+    printf("\nContent :- \n");
+    print_whole_content(temp_ind);
+    printf("\n");
+
+    // Checking if a valid birthday exists
+    if (temp_ind->birthday->tm_mday == -1)
+        printf("\nHas no valid birthday\n\n");
+    else
+        printf("Birthday :- %d/%d/%d\n\n", temp_ind->birthday->tm_mday, temp_ind->birthday->tm_mon, temp_ind->birthday->tm_year);
+}
+
+// Function to print the attributes of a business node
+static void print_business(void *node)
+{
+    struct business *temp_bus = (struct business *)node; // Temporary pointer to access the node data
+
+    // Printing the attributes
+
+    printf("\nName of the Business :- %s\n", temp_bus->name);
+    printf("\nID- %d\n", temp_bus->id);
+    printf("\nCreation date :- %d/%d/%d\n", temp_bus->creation->tm_mday, temp_bus->creation->tm_mon, temp_bus->creation->tm_year);
+    printf("\nContent :-\n");
+    print_whole_content(temp_bus);
+    printf("\n");
+
+    printf("\nThe co-ordinates of the business are (%.3lf, %.3lf) \n", temp_bus->x_cord, temp_bus->y_cord);
+
+    // Printing the owners and the customers
+    if (temp_bus->owners != NULL)
+    {
+        struct linked_individual *temp = temp_bus->owners;
+
+        int num = 1; // Count of nodes
+        printf("\nList of owner(s)\n\n");
+
+        while (temp != NULL)
+        {
+            printf("%d) %s\n", num++, temp->node_ind->name); // Printing the owner's names
+
+            temp = temp->next;
+        }
+    }
+    else
+        printf("\nThere are no owners\n");
+
+    if (temp_bus->customers != NULL)
+    {
+        struct linked_individual *temp = temp_bus->customers;
+
+        int num = 1; // Count of nodes
+        printf("\nList of customer(s)\n");
+
+        while (temp != NULL)
+        {
+            printf("%d) %s\n", num++, temp->node_ind->name); // Printing the customer's name
+
+            temp = temp->next;
+        }
+    }
+    else
+        printf("\nThere are no customers\n");
+}
+
+// Function to print the attributes of an organisation node
+static void print_organisation(void *node)
+{
+    struct organisation *temp_org = (struct organisation *)node; // Temporary pointer to access the node data
+
+    // Printing the attributes
+
+    printf("Name of the Organisation :- %s\n", temp_org->name);
+    printf("ID- %d\n", temp_org->id);
+    printf("Creation date :- %d/%d/%d\n", temp_org->creation->tm_mday, temp_org->creation->tm_mon, temp_org->creation->tm_year);
+    printf("Content :-\n");
+    print_whole_content(temp_org);
+    printf("\n");
+
+    printf("The co-ordinates of the organisation are (%.3lf, %.3lf) \n", temp_org->x_cord, temp_org->y_cord);
+
+    // Printing the Individual members
+
+    if (temp_org->orgmember_head != NULL)
+    {
+        struct linked_individual *temp = temp_org->orgmember_head;
+
+        int num = 1; // Count of nodes
+        printf("\nList of Individual member(s)\n");
+
+        while (temp != NULL)
+        {
+            printf("%d) %s\n", num++, temp->node_ind->name); // Printing the names
+
+            temp = temp->next;
+        }
+    }
+    else
+        printf("\nThere are no Individual members\n");
+}
+
+// Function to print the attributes of a group node
+static void print_group(void *node)
+{
+    struct group *temp_grp = (struct group *)node; // Temporary pointer to access the node data
+
+    // Printing the attributes
+
+    printf("\nName of the Group :- %s\n", temp_grp->name);
+    printf("\nID- %d\n", temp_grp->id);
+    printf("\nCreation date :- %d/%d/%d\n", temp_grp->creation->tm_mday, temp_grp->creation->tm_mon, temp_grp->creation->tm_year);
+    printf("\nContent :-\n");
+    print_whole_content(temp_grp);
+    printf("\n");
+
+    printf("The co-ordinates of the group are (%.3lf, %.3lf) \n", temp_grp->x_cord, temp_grp->y_cord);
+
+    // Printing the Individual and Business members
+
+    if (temp_grp->grpmember_head != NULL)
+    {
+        struct linked_individual *temp = temp_grp->grpmember_head;
+
+        int num = 1; // Counts of nodes
+        printf("\nList of individual member(s)\n");
+
+        while (temp != NULL)
+        {
+            printf("%d) %s\n", num++, temp->node_ind->name); // Printing the Individual's name
+
+            temp = temp->next;
+        }
+    }
+    else
+        printf("\nThere are no individual members\n\n");
+
+    if (temp_grp->businessmember_head != NULL)
+    {
+        struct linked_business *temp2 = temp_grp->businessmember_head;
+
+        int num = 1; // Count of nodes
+        printf("List of business member(s)\n\n");
+
+        while (temp2 != NULL)
+        {
+            printf("%d) %s\n", num++, temp2->node_bus->name); // Printing the Businesse's name
+
+            temp2 = temp2->next;
+        }
+    }
+    else
+        printf("\nThere are no business members\n");
+}
+
+// Table describing each kind of node, indexed by enum node_kind
+const struct node_kind_info kind_info[4] = {
+    {"Individual", offsetof(struct individual, id), offsetof(struct individual, name), offsetof(struct individual, creation), offsetof(struct individual, content), offsetof(struct individual, posts), offsetof(struct individual, csr_index), offsetof(struct individual, component), offsetof(struct individual, score),
+     offsetof(struct individual, next), offsetof(struct individual, pprev), print_individual},
+    {"Business", offsetof(struct business, id), offsetof(struct business, name), offsetof(struct business, creation), offsetof(struct business, content), offsetof(struct business, posts), offsetof(struct business, csr_index), offsetof(struct business, component), offsetof(struct business, score),
+     offsetof(struct business, next), offsetof(struct business, pprev), print_business},
+    {"Organisation", offsetof(struct organisation, id), offsetof(struct organisation, name), offsetof(struct organisation, creation), offsetof(struct organisation, content), offsetof(struct organisation, posts), offsetof(struct organisation, csr_index), offsetof(struct organisation, component), offsetof(struct organisation, score),
+     offsetof(struct organisation, next), offsetof(struct organisation, pprev), print_organisation},
+    {"Group", offsetof(struct group, id), offsetof(struct group, name), offsetof(struct group, creation), offsetof(struct group, content), offsetof(struct group, posts), offsetof(struct group, csr_index), offsetof(struct group, component), offsetof(struct group, score),
+     offsetof(struct group, next), offsetof(struct group, pprev), print_group},
+};
+
+// Function to find the kind a type string refers to
+int kind_from_type(char type[])
+{
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+    {
+        if (!(strcmp(type, kind_info[kind].type)))
+            return kind;
+    }
+
+    return -1; // Not a type
+}
+
+// Function to print a given node
+void print_node(void *node)
+{
+
+    if (node == NULL) // Empty node check
+        return;
+
+    kind_info[NODE_KIND(node)].print(node); // Printing through the function of the node's kind
+
+    if (pagerank_ready)
+        printf("\nInfluence score :- %.6f\n", NODE_SCORE(node));
+
+    printf("\n*******************\n");
+}
+
+// Function search for a node with the given search_parameter
+void search(char search_parameter[])
+{
+
+    int flag = 1;
+
+    int search_kind = kind_from_type(search_parameter);                             // The parameter is checked for being a type only once
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+    {
+        // Printing the nodes with a matching name, found through the name index of the type
+        struct name_entry *entry = name_index_find(kind, search_parameter);
+
+        while (entry != NULL)
+        {
+            flag = 0;
+
+            printf("\nThe node is:- \n\n");
+            print_node(entry->node);
+
+            entry = name_index_next(entry);
+        }
+
+        if (kind != search_kind)                                                    // The parameter is not this type
+            continue;
+
+        // Printing all the nodes of the type, except the ones already printed for their name
+
+        if (kind == NODE_INDIVIDUAL)
+        {
+            for (struct individual *temp_ind = all_Individuals; temp_ind != NULL; temp_ind = temp_ind->next)
+            {
+                if (!(strcmp(search_parameter, temp_ind->name)))
+                    continue;
+
+                if (flag)
+                {
+                    flag = 0;
+                    printf("\nThe Individual node(s) are:-\n");
+                }
+
+                print_node(temp_ind);
+            }
+        }
+        else if (kind == NODE_BUSINESS)
+        {
+            for (struct business *temp_bus = all_business; temp_bus != NULL; temp_bus = temp_bus->next)
+            {
+                if (!(strcmp(search_parameter, temp_bus->name)))
+                    continue;
+
+                if (flag)
+                {
+                    flag = 0;
+                    printf("\nThe Business node(s) are:-\n");
+                }
+
+                print_node(temp_bus);
+            }
+        }
+        else if (kind == NODE_ORGANISATION)
+        {
+            for (struct organisation *temp_org = all_Organisation; temp_org != NULL; temp_org = temp_org->next)
+            {
+                if (!(strcmp(search_parameter, temp_org->name)))
+                    continue;
+
+                if (flag)
+                {
+                    flag = 0;
+                    printf("\nThe Organisation node(s) are:-\n");
+                }
+
+                print_node(temp_org);
+            }
+        }
+        else
+        {
+            for (struct group *temp_grp = all_Group; temp_grp != NULL; temp_grp = temp_grp->next)
+            {
+                if (!(strcmp(search_parameter, temp_grp->name)))
+                    continue;
+
+                if (flag)
+                {
+                    flag = 0;
+                    printf("\nThe Group node(s) are:-\n");
+                }
+
+                print_node(temp_grp);
+            }
+        }
+    }
+
+    if (flag)
+        printf("No match found\n");
+}
+
+// Function to search by id
+void *search_by_id(int id)
+{
+    struct id_slot *slot = id_index_find(id);                               // Looking up the ID index
+
+    if (slot == NULL)                                                       // There is no match
+    {
+        printf("No such node exists\n");
+        return NULL;
+    }
+
+    return slot->node;
+}
+
+// Function to search by birthday
+void search_by_birthday(struct tm *search_date)
+{
+    // Only the individuals born on the same date are looked at, through the birthday index
+    int count = (search_date->tm_mday == -1) ? 0 : birthdays_on(search_date->tm_mday, search_date->tm_mon, search_date->tm_year);
+
+    if (count <= 0)
+    {
+        printf("There are no nodes with the given birthday\n\n");                                       // If there are no matches
+        return;
+    }
+
+    printf("The node(s) are :- \n\n");
+
+    for (int i = 0; i < count; i++)
+        print_node(found_nodes[i]);                                                                     // Printing all the nodes who match
+}
+
+// Function to print the content of a node
+void print_content(int id)
+{
+    struct id_slot *slot = id_index_find(id);                                       // Looking up the ID index
+
+    if (slot == NULL)
+    {
+        printf("No such node exists\n");                                            // Checking if there is no node matching
+        return;
+    }
+
+    printf("The content of the node with ID %d is:- \n\n", id);                     // Printing the name and content
+    print_whole_content(slot->node);                                                // of the node found
+    printf("\n\n");
+}
+
+// Function to print the content of a node followed by all of it's posts
+void print_whole_content(void *node)
+{
+    struct post_cursor cursor;
+    char *post;
+
+    fputs(NODE_CONTENT(node), stdout);
+
+    post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+    while ((post = post_log_next(&cursor)) != NULL)
+        printf("\n\n%s", post);
+}
+
+// Function to print a page of the posts of a node, one per line
+int print_posts(int id, int first, int count)
+{
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return -1;
+
+    struct post_cursor cursor;
+    char *post;
+    int printed = 0;
+
+    post_log_seek(NODE_POSTS(slot->node), first, &cursor);
+
+    while (printed < count && (post = post_log_next(&cursor)) != NULL)
+    {
+        printf("%s\n", post);
+        printed++;
+    }
+
+    return printed;
+}
+
+// Function to search nodes to link them
+void *search_to_link(char search_parameter[], enum node_kind kind)
+{
+    struct name_entry *entry = NULL;
+
+    if (kind == NODE_INDIVIDUAL || kind == NODE_BUSINESS)                           // Only individuals and businesses are linked as members
+        entry = name_index_find(kind, search_parameter);
+
+    if (entry == NULL)
+        return NULL;                                                                 // NULL is returned if a node isn't found
+
+    return entry->node;
+}
+
+// Function to write a date as DD/MM/YYYY, or "-" if there is none, the way the batch commands take it
+static void date_text(char *buffer, struct tm *date)
+{
+    if (date == NULL)
+        strcpy(buffer, "-");
+    else
+        sprintf(buffer, "%d/%d/%d", date->tm_mday, date->tm_mon, date->tm_year);
+}
+
+// Function to remove a node from it's global list
+static void node_list_unlink(void *node)
+{
+    *NODE_PPREV(node) = NODE_NEXT(node);
+
+    if (NODE_NEXT(node) != NULL)
+        NODE_PPREV(NODE_NEXT(node)) = NODE_PPREV(node);
+}
+
+// Function to undo a node that couldn't be added to every index, stage being the number of indexes it was added
+// to. The index that failed may hold part of the node, so it is cleared out too. The attributes are left to the caller
+static void create_rollback(void *node, int stage)
+{
+    enum node_kind kind = NODE_KIND(node);
+    int id = NODE_ID(node);
+
+    if (stage >= 5 && kind == NODE_INDIVIDUAL)
+        birthday_index_remove(id, ((struct individual *)node)->birthday);
+    if (stage >= 4)
+        spatial_index_remove(node);
+    if (stage >= 3)
+        trigram_index_remove(id, NODE_CONTENT(node));
+    if (stage >= 2)
+        word_index_remove(id, NODE_CONTENT(node));
+    if (stage >= 1)
+        name_index_remove(kind, NODE_NAME(node), node);
+
+    id_index_remove(id);
+    node_list_unlink(node);
+    pool_free(node_pools[kind], node);
+}
+
+// Function to allocate a node and add it to the front of it's global list, without adding it to any index
+static void *node_alloc(enum node_kind kind, int id, char *name, struct tm *creation, char *content, struct tm *birthday, double x_cord, double y_cord)
+{
+    void *node = NULL;
+
+    if (kind == NODE_INDIVIDUAL)
+    {
+        // Allocation memory for a new Individual type node
+        struct individual *ind_node = (struct individual *)pool_alloc(&individual_pool);
+
+        if (ind_node == NULL)
+            return NULL;
+
+        // Unique attribute
+        ind_node->birthday = birthday;
+
+        // Initializing the back pointers to NULL
+
+        ind_node->back_bus = NULL;
+        ind_node->back_grp = NULL;
+        ind_node->back_org = NULL;
+
+        // Linking the created node to the global list
+        ind_node->next = all_Individuals;
+        ind_node->pprev = &all_Individuals;
+
+        if (all_Individuals != NULL)
+            all_Individuals->pprev = &ind_node->next;
+
+        all_Individuals = ind_node;
+
+        node = ind_node;
+    }
+    else if (kind == NODE_BUSINESS)
+    {
+        struct business *bus_node = (struct business *)pool_alloc(&business_pool);
+
+        if (bus_node == NULL)
+            return NULL;
+
+        // Unique attributes, the owners and customers are linked later
+        bus_node->x_cord = x_cord;
+        bus_node->y_cord = y_cord;
+        bus_node->owners = NULL;
+        bus_node->customers = NULL;
+
+        // Initializing the back pointer to NULL
+        bus_node->back_grp = NULL;
+
+        // Linking the created node to the global linked list
+        bus_node->next = all_business;
+        bus_node->pprev = &all_business;
+
+        if (all_business != NULL)
+            all_business->pprev = &bus_node->next;
+
+        all_business = bus_node;
+
+        node = bus_node;
+    }
+    else if (kind == NODE_ORGANISATION)
+    {
+        struct organisation *org_node = (struct organisation *)pool_alloc(&organisation_pool);
+
+        if (org_node == NULL)
+            return NULL;
+
+        // Unique attributes, the members are linked later
+        org_node->x_cord = x_cord;
+        org_node->y_cord = y_cord;
+        org_node->orgmember_head = NULL;
+
+        // Linking the created node to the global list
+        org_node->next = all_Organisation;
+        org_node->pprev = &all_Organisation;
+
+        if (all_Organisation != NULL)
+            all_Organisation->pprev = &org_node->next;
+
+        all_Organisation = org_node;
+
+        node = org_node;
+    }
+    else
+    {
+        struct group *grp_node = (struct group *)pool_alloc(&group_pool);
+
+        if (grp_node == NULL)
+            return NULL;
+
+        // Unique attributes, the members are linked later
+        grp_node->x_cord = x_cord;
+        grp_node->y_cord = y_cord;
+        grp_node->businessmember_head = NULL;
+        grp_node->grpmember_head = NULL;
+
+        // Adding this group node to the global list
+        grp_node->next = all_Group;
+        grp_node->pprev = &all_Group;
+
+        if (all_Group != NULL)
+            all_Group->pprev = &grp_node->next;
+
+        all_Group = grp_node;
+
+        node = grp_node;
+    }
+
+    // Setting the kind first, as the common attributes are reached through it
+    *(unsigned char *)node = (unsigned char)kind;
+
+    NODE_ID(node) = id;
+    NODE_NAME(node) = name;
+    *NODE_FIELD(node, struct tm *, creation) = creation;
+    NODE_CONTENT(node) = content;
+    NODE_POSTS(node) = NULL;
+    NODE_SCORE(node) = 0;                                   // Not scored till the next PageRank computation
+
+    return node;
+}
+
+// Function to create a node from it's attributes
+void *create_node(enum node_kind kind, int id, char *name, struct tm *creation, char *content, struct tm *birthday, double x_cord, double y_cord)
+{
+    // Ids have to be unique, so the node is rejected if the id is already in use
+    if (id_index_find(id) != NULL)
+        return NULL;
+
+    void *node = node_alloc(kind, id, name, creation, content, birthday, x_cord, y_cord);
+
+    if (node == NULL)
+        return NULL;
+
+    // Adding the node to the indexes, stage counting the ones it was added to so that they can be undone on a failure
+    int stage = 0;
+
+    if (id_index_insert(id, kind, node))                    // Adding the node to the ID index
+        stage = 1;
+    if (stage == 1 && name_index_insert(kind, name, node))  // and to the name index of it's kind
+        stage = 2;
+    if (stage == 2 && word_index_add(id, content))          // and it's words to the word index
+        stage = 3;
+    if (stage == 3 && trigram_index_add(id, content))       // along with it's trigrams
+        stage = 4;
+    if (stage == 4 && spatial_index_insert(node))           // and it's coordinates to the spatial index
+        stage = 5;
+    if (stage == 5 && (kind != NODE_INDIVIDUAL || birthday_index_insert(id, birthday)))
+        stage = 6;
+
+    if (stage < 6)
+    {
+        create_rollback(node, stage);
+        return NULL;
+    }
+
+    components_add_node(node);                              // The node is a component of it's own till it is linked
+    csr_mark_stale();                                       // The snapshot no longer has this node and it's links
+    content_arena_mark_stale();
+
+    // Logging the node in the same form as the create command
+    char creation_text[40], birthday_text[40];
+
+    date_text(creation_text, creation);
+
+    if (kind == NODE_INDIVIDUAL)
+    {
+        date_text(birthday_text, birthday);
+        wal_record("create|%s|%d|%s|%s|%s|%s", kind_info[kind].type, id, name, creation_text, birthday_text, content);
+    }
+    else
+        wal_record("create|%s|%d|%s|%s|%.17g|%.17g|%s", kind_info[kind].type, id, name, creation_text, x_cord, y_cord, content);
+
+    return node;
+}
+
+// Function to get the heads of the link lists of a node, in the order in which csr_node_links() walks them
+static int node_list_heads(void *node, struct linked_cell **heads[3])
+{
+    if (NODE_KIND(node) == NODE_INDIVIDUAL)
+    {
+        struct individual *temp_ind = (struct individual *)node;
+
+        heads[0] = (struct linked_cell **)&temp_ind->back_bus;
+        heads[1] = (struct linked_cell **)&temp_ind->back_org;
+        heads[2] = (struct linked_cell **)&temp_ind->back_grp;
+        return 3;
+    }
+    else if (NODE_KIND(node) == NODE_BUSINESS)
+    {
+        struct business *temp_bus = (struct business *)node;
+
+        heads[0] = (struct linked_cell **)&temp_bus->back_grp;
+        heads[1] = (struct linked_cell **)&temp_bus->owners;
+        heads[2] = (struct linked_cell **)&temp_bus->customers;
+        return 3;
+    }
+    else if (NODE_KIND(node) == NODE_ORGANISATION)
+    {
+        heads[0] = (struct linked_cell **)&((struct organisation *)node)->orgmember_head;
+        return 1;
+    }
+
+    heads[0] = (struct linked_cell **)&((struct group *)node)->grpmember_head;
+    heads[1] = (struct linked_cell **)&((struct group *)node)->businessmember_head;
+    return 2;
+}
+
+// Function to add a cell to the front of a list
+static void cell_push(struct linked_cell **head, struct linked_cell *cell)
+{
+    cell->next = *head;
+    cell->pprev = head;
+
+    if (*head != NULL)
+        (*head)->pprev = &cell->next;
+
+    *head = cell;
+}
+
+// Function to take a cell out of it's list in O(1)
+static void cell_unlink(struct linked_cell *cell)
+{
+    *cell->pprev = cell->next;
+
+    if (cell->next != NULL)
+        cell->next->pprev = cell->pprev;
+}
+
+// Function to link a member to a business, organisation or group
+int link_member(void *container, void *member, enum link_role role)
+{
+    enum node_kind container_kind = NODE_KIND(container);
+    enum node_kind member_kind = NODE_KIND(member);
+
+    struct linked_cell **member_list;   // List of the container the member goes into
+    struct linked_cell **back_list;     // List of back pointers of the member the container goes into
+
+    if (container_kind == NODE_BUSINESS && member_kind == NODE_INDIVIDUAL && role != LINK_MEMBER)
+    {
+        // Owners and customers are kept in separate lists
+        member_list = (struct linked_cell **)((role == LINK_OWNER) ? &((struct business *)container)->owners : &((struct business *)container)->customers);
+        back_list = (struct linked_cell **)&((struct individual *)member)->back_bus;
+    }
+    else if (container_kind == NODE_ORGANISATION && member_kind == NODE_INDIVIDUAL && role == LINK_MEMBER)
+    {
+        member_list = (struct linked_cell **)&((struct organisation *)container)->orgmember_head;
+        back_list = (struct linked_cell **)&((struct individual *)member)->back_org;
+    }
+    else if (container_kind == NODE_GROUP && member_kind == NODE_INDIVIDUAL && role == LINK_MEMBER)
+    {
+        member_list = (struct linked_cell **)&((struct group *)container)->grpmember_head;
+        back_list = (struct linked_cell **)&((struct individual *)member)->back_grp;
+    }
+    else if (container_kind == NODE_GROUP && member_kind == NODE_BUSINESS && role == LINK_MEMBER)
+    {
+        member_list = (struct linked_cell **)&((struct group *)container)->businessmember_head;
+        back_list = (struct linked_cell **)&((struct business *)member)->back_grp;
+    }
+    else
+        return 0; // Such a link doesn't exist between these kinds
+
+    // Allocating the cell pointing to the member and the back pointer cell pointing to the container
+    struct linked_cell *new_member = (struct linked_cell *)pool_alloc(linked_pools[member_kind]);
+    struct linked_cell *new_back = (struct linked_cell *)pool_alloc(linked_pools[container_kind]);
+
+    if (new_member == NULL || new_back == NULL)
+    {
+        pool_free(linked_pools[member_kind], new_member);
+        pool_free(linked_pools[container_kind], new_back);
+        return 0;
+    }
+
+    new_member->node = member;
+    new_back->node = container;
+
+    // The two cells point to each other, so either node can remove the link on it's own
+    new_member->twin = new_back;
+    new_back->twin = new_member;
+
+    cell_push(member_list, new_member);
+    cell_push(back_list, new_back);
+
+    csr_mark_stale();
+    components_add_link(container, member);
+
+    char *role_names[] = {"member", "owner", "customer"};
+    wal_record("link|%d|%d|%s", NODE_ID(container), NODE_ID(member), role_names[role]);
+
+    return 1;
+}
+
+// Function to take a Y/N answer from the user
+static char yes_no_input()
+{
+    char check;
+    scanf("%c%c", &check, &throwaway);
+
+    while (check != 'Y' && check != 'y' && check != 'N' && check != 'n')            // Iterating till the correct character is used
+    {
+        printf("Error!! Please enter the correct characer (Y/N)\n");
+        scanf("%c%c", &check, &throwaway);
+    }
+
+    return check;
+}
+
+// Function to take input for the members of a given role and link them
+static void members_input(void *container, enum node_kind member_kind, enum link_role role, char question[], char prompt[])
+{
+    printf("%s", question);
+
+    char check = yes_no_input();
+
+    while (check == 'Y' || check == 'y')                                            // Loop to add new members
+    {
+        printf("%s", prompt);
+
+        char *member_name = name_input();
+
+        void *member = search_to_link(member_name, member_kind);                    // Finding the member by it's name
+
+        if (member == NULL)
+            printf("Such a name doesn't exist\n");
+        else if (!link_member(container, member, role))
+            printf("Memory allocation failed. Please try again\n");
+        else
+            printf("Successfully added!!\n");
+
+        free(member_name);
+
+        printf("Do you want to enter any other names (Y/N) ??\n");                  // Asking if there are any other names
+        check = yes_no_input();
+    }
+}
+
+// Function to create a new  node
+void new_node(enum node_kind kind)
+{
+    // Taking inputs for the common attributes
+
+    int id;
+
+    printf("\nEnter the ID of the %s\n", kind_info[kind].type);
+    scanf("%d%c", &id, &throwaway);
+
+    // Ids have to be unique, so the node is rejected if the id is already in use
+    if (id_index_find(id) != NULL)
+    {
+        printf("A node with the ID %d already exists\n", id);
+        return;
+    }
+
+    printf("Enter the name of the %s\n", kind_info[kind].type);
+    char *name = name_input();
+
+    printf("Enter the creation date in the format DD/MM/YYYY\n");
+    struct tm *creation = date_input();
+
+    printf("Enter the content of the %s\n", kind_info[kind].type);
+    char *content = content_input();
+
+    // Inputs for the unique attributes
+
+    struct tm *birthday = NULL;
+    double x_cord = 0, y_cord = 0;
+
+    if (kind == NODE_INDIVIDUAL)
+        birthday = birthday_input();
+    else
+    {
+        printf("\nEnter the X Co-ordinate\n");
+        scanf("%lf%c", &x_cord, &throwaway);
+
+        printf("Enter the Y Co-ordinate\n");
+        scanf("%lf%c", &y_cord, &throwaway);
+    }
+
+    void *node = create_node(kind, id, name, creation, content, birthday, x_cord, y_cord);
+
+    // Checking if allocation was successful
+    if (node == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+
+        free(name);
+        free(creation);
+        free(content);
+        free(birthday);
+        return;
+    }
+
+    // Taking input for the members of the node
+    if (kind == NODE_BUSINESS)
+    {
+        members_input(node, NODE_INDIVIDUAL, LINK_OWNER, "\nDo you want to enter any owner(s) (Y/N)\n", "Enter the name of owner\n");
+        members_input(node, NODE_INDIVIDUAL, LINK_CUSTOMER, "Do you want to enter any customer(s) (Y/N)\n", "Enter the name of customer\n");
+    }
+    else if (kind == NODE_ORGANISATION)
+    {
+        members_input(node, NODE_INDIVIDUAL, LINK_MEMBER, "Do you want to enter any member(s) (Y/N)\n", "Enter the name of member\n");
+    }
+    else if (kind == NODE_GROUP)
+    {
+        members_input(node, NODE_INDIVIDUAL, LINK_MEMBER, "Do you want to enter any individual member(s) (Y/N)\n", "Enter the name of individual member\n");
+        members_input(node, NODE_BUSINESS, LINK_MEMBER, "\nDo you want to enter any business member(s) (Y/N)\n", "Enter the name of member\n");
+    }
+
+    printf("******** Node successfully created ********\n");
+}
+
+// Function to print one-hop nodes
+void one_hop(int id)
+{
+    struct id_slot *slot = id_index_find(id);                                           // Looking up the node in the ID index
+    struct csr_graph *graph = csr_snapshot();                                           // and the links in the CSR snapshot
+
+    if (slot == NULL || graph == NULL)
+    {
+        printf("There are no 1-hop nodes\n");                                           // Case to chekc if there was no match
+        return;
+    }
+
+    int index = NODE_CSR_INDEX(slot->node);
+
+    int start = graph->offsets[index];
+    int end = graph->offsets[index + 1];
+
+    if (start == end)
+    {
+        printf("There are no 1-hop nodes\n");                                           // or no 1-hop nodes
+        return;
+    }
+
+    printf("The 1-hop nodes are:- \n\n");
+
+    // Printing the back pointed nodes followed by the members, all of them are stored next to each other
+    for (int i = start; i < end; i++)
+        print_node(graph->nodes[graph->neighbors[i]]);
+}
+
+// Function to start a new epoch of the stamps, nodes stamped with it have already been reached by the query running
+static void csr_new_epoch(struct csr_graph *graph)
+{
+    graph->epoch++;
+
+    if (graph->epoch == 0)                                                                      // The counter wrapped around, so the old stamps are cleared
+    {
+        memset(graph->stamps, 0, (size_t)graph->node_count * sizeof(unsigned int));
+        graph->epoch = 1;
+    }
+}
+
+// Function to collect the two-hop nodes of a given individual node
+int two_hop_collect(struct individual *node)
+{
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL)
+        return -1;
+
+    // Starting a new epoch, individuals stamped with it have already been reached by this query
+    csr_new_epoch(graph);
+
+    int self = node->csr_index;
+    graph->stamps[self] = graph->epoch;                                                         // The given node is never a two-hop node of itself
+
+    int count = 0; // Number of two-hop nodes found
+
+    // Going over the organisations and groups the node is a member of
+    for (int i = graph->offsets[self]; i < graph->offsets[self + 1]; i++)
+    {
+        int container = graph->neighbors[i];
+
+        if (graph->kinds[container] != NODE_ORGANISATION && graph->kinds[container] != NODE_GROUP)
+            continue;
+
+        // Adding the individual members, the business members of a group are skipped
+        for (int j = graph->offsets[container]; j < graph->offsets[container + 1]; j++)
+        {
+            int member = graph->neighbors[j];
+
+            if (graph->kinds[member] != NODE_INDIVIDUAL || graph->stamps[member] == graph->epoch)  // Skipping if it has already been added (or is the node itself)
+                continue;
+
+            graph->stamps[member] = graph->epoch;
+
+            // Growing the reused buffer only when a query finds more nodes than any query before it
+            if (count == two_hop_capacity)
+            {
+                int new_capacity = two_hop_capacity ? two_hop_capacity * 2 : 64;
+                int *temp = (int *)realloc(two_hop_buffer, new_capacity * sizeof(int));
+
+                if (temp == NULL)
+                {
+                    printf("Memory allocation failed. Please try again\n");
+                    return -1;
+                }
+
+                two_hop_buffer = temp;
+                two_hop_capacity = new_capacity;
+            }
+
+            two_hop_buffer[count++] = member;
+        }
+    }
+
+    return count;
+}
+
+// Function to print two-hop nodes for a given INdividual node
+void two_hop(struct individual *node)
+{
+    int count = two_hop_collect(node);
+
+    if (count < 0)
+        return;
+
+    struct csr_graph *graph = &membership_graph;
+
+    // Checking if there are any two-hop nodes
+    if (count == 0)
+    {
+        printf("There are no two-hop nodes\n"); 
+        return;
+    }
+
+    // Printing the nodes now, latest found first
+    printf("The two-hop nodes are:-\n\n");
+
+    for (int i = count - 1; i >= 0; i--)
+    {
+        struct individual *temp = (struct individual *)graph->nodes[two_hop_buffer[i]];
+
+        printf("Name :- %s\n", temp->name);                                                      // Printing the name and
+        printf("Content:- \n");                                                                 // content of all the two hop nodes
+        print_whole_content(temp);
+        printf("\n");
+    }
+}
+
+// Function run by every thread of a pool, waits for a job and runs it's part of it till the pool is stopped
+static void *thread_pool_main(void *arg)
+{
+    struct thread_pool *pool = &bfs_pool;
+    int worker = (int)(long)arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (1)
+    {
+        while (!pool->stopping && pool->generation == seen)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+
+        if (pool->stopping)
+            break;
+
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool->job(worker, pool->arg);
+
+        pthread_mutex_lock(&pool->lock);
+
+        if (--pool->running == 0)
+            pthread_cond_signal(&pool->done);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+// Function to stop the threads of the pool
+void thread_pool_stop()
+{
+    struct thread_pool *pool = &bfs_pool;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->count; i++)
+        pthread_join(pool->threads[i - 1], NULL);
+
+    free(pool->threads);
+
+    pool->threads = NULL;
+    pool->count = 1;
+    pool->stopping = 0;
+}
+
+// Function to start the threads of the pool, the calling thread being one of them
+int thread_pool_start(int threads)
+{
+    struct thread_pool *pool = &bfs_pool;
+
+    if (threads < 1)
+        return 0;
+
+    thread_pool_stop();
+
+    // Every thread gets it's own queue and buffer for the nodes it finds
+    if (bfs_worker_count < threads)
+    {
+        struct bfs_worker *temp = (struct bfs_worker *)realloc(bfs_workers, threads * sizeof(struct bfs_worker));
+
+        if (temp == NULL)
+            return 0;
+
+        memset(temp + bfs_worker_count, 0, (threads - bfs_worker_count) * sizeof(struct bfs_worker));
+
+        bfs_workers = temp;
+        bfs_worker_count = threads;
+    }
+
+    if (threads == 1)
+        return 1;
+
+    pool->threads = (pthread_t *)malloc((threads - 1) * sizeof(pthread_t));
+
+    if (pool->threads == NULL)
+        return 0;
+
+    // A thread that can't be created leaves the pool smaller, rather than failing the start
+    while (pool->count < threads && pthread_create(&pool->threads[pool->count - 1], NULL, thread_pool_main, (void *)(long)pool->count) == 0)
+        pool->count++;
+
+    return 1;
+}
+
+// Function to run a job on every thread of the pool, returns once all of them are done
+static void thread_pool_run(void (*job)(int worker, void *arg), void *arg, int threads)
+{
+    struct thread_pool *pool = &bfs_pool;
+
+    if (threads <= 1 || pool->count <= 1)
+    {
+        job(0, arg);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->arg = arg;
+    pool->running = pool->count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    job(0, arg);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->running > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Function to make room in the k-hop buffers for a graph and a number of levels
+static int k_hop_reserve(struct csr_graph *graph, int levels)
+{
+    int words = graph->node_count / 64 + 1;
+
+    if (k_hop_capacity < graph->node_count)
+    {
+        int *temp = (int *)realloc(k_hop_nodes, graph->node_count * sizeof(int));
+
+        if (temp == NULL)
+            return 0;
+
+        k_hop_nodes = temp;
+        k_hop_capacity = graph->node_count;
+    }
+
+    if (k_hop_ends_capacity < levels + 1)
+    {
+        int *temp = (int *)realloc(k_hop_ends, (levels + 1) * sizeof(int));
+
+        if (temp == NULL)
+            return 0;
+
+        k_hop_ends = temp;
+        k_hop_ends_capacity = levels + 1;
+    }
+
+    if (k_hop_frontier_words < words)
+    {
+        unsigned long long *frontier = (unsigned long long *)realloc(k_hop_frontier, words * sizeof(unsigned long long));
+
+        if (frontier == NULL)
+            return 0;
+
+        k_hop_frontier = frontier;
+
+        unsigned long long *visited = (unsigned long long *)realloc(k_hop_visited, words * sizeof(unsigned long long));
+
+        if (visited == NULL)
+            return 0;
+
+        k_hop_visited = visited;
+        k_hop_frontier_words = words;
+    }
+
+    return 1;
+}
+
+// Function to add a node to the ones a worker found in the level being expanded
+static void bfs_worker_add(struct bfs_worker *worker, struct csr_graph *graph, int node)
+{
+    if (worker->count == worker->capacity)
+    {
+        int new_capacity = worker->capacity ? worker->capacity * 2 : 256;
+        int *temp = (int *)realloc(worker->found, new_capacity * sizeof(int));
+
+        if (temp == NULL)
+        {
+            worker->failed = 1;
+            return;
+        }
+
+        worker->found = temp;
+        worker->capacity = new_capacity;
+    }
+
+    worker->found[worker->count++] = node;
+    worker->links += graph->offsets[node + 1] - graph->offsets[node];
+}
+
+// Function to expand a chunk of a level of a k-hop query
+static void k_hop_expand_chunk(struct k_hop_level *level, struct bfs_worker *worker, int chunk)
+{
+    struct csr_graph *graph = level->graph;
+
+    if (!level->bottom_up)
+    {
+        // Top-down, the nodes of the chunk of the frontier mark their neighbours not reached yet. Setting the bit
+        // atomically lets only the first thread to reach a node add it
+        int end = level->start + (chunk + 1) * K_HOP_CHUNK_TOP_DOWN;
+
+        if (end > level->end)
+            end = level->end;
+
+        for (int i = level->start + chunk * K_HOP_CHUNK_TOP_DOWN; i < end; i++)
+        {
+            int node = k_hop_nodes[i];
+
+            for (int j = graph->offsets[node]; j < graph->offsets[node + 1]; j++)
+            {
+                int neighbour = graph->neighbors[j];
+                unsigned long long bit = 1ULL << (neighbour % 64);
+
+                if (__atomic_load_n(&k_hop_visited[neighbour / 64], __ATOMIC_RELAXED) & bit)
+                    continue;
+
+                if (level->threads == 1)
+                    k_hop_visited[neighbour / 64] |= bit;               // No other thread to race with
+                else if (__atomic_fetch_or(&k_hop_visited[neighbour / 64], bit, __ATOMIC_RELAXED) & bit)
+                    continue;
+
+                bfs_worker_add(worker, graph, neighbour);
+            }
+        }
+    }
+    else
+    {
+        // Bottom-up, the nodes of the chunk not reached yet look for a neighbour in the frontier bitmap. Only this
+        // thread looks at them, but their bits share words with nodes of other chunks
+        int end = (chunk + 1) * K_HOP_CHUNK_BOTTOM_UP;
+
+        if (end > graph->node_count)
+            end = graph->node_count;
+
+        for (int node = chunk * K_HOP_CHUNK_BOTTOM_UP; node < end; node++)
+        {
+            unsigned long long bit = 1ULL << (node % 64);
+
+            if (__atomic_load_n(&k_hop_visited[node / 64], __ATOMIC_RELAXED) & bit)
+                continue;
+
+            for (int j = graph->offsets[node]; j < graph->offsets[node + 1]; j++)
+            {
+                int neighbour = graph->neighbors[j];
+
+                if (k_hop_frontier[neighbour / 64] & (1ULL << (neighbour % 64)))
+                {
+                    __atomic_fetch_or(&k_hop_visited[node / 64], bit, __ATOMIC_RELAXED);
+                    bfs_worker_add(worker, graph, node);
+                    break; // A single neighbour in the frontier is enough
+                }
+            }
+        }
+    }
+}
+
+// Function run by every thread to expand a level of a k-hop query, the chunks of it's own queue first and then the
+// ones left in the queues of the other threads
+static void k_hop_expand(int worker, void *arg)
+{
+    struct k_hop_level *level = (struct k_hop_level *)arg;
+    int chunk;
+
+    if (worker >= level->threads)
+        return; // Not needed for a level this small
+
+    for (int i = 0; i < level->threads; i++)
+    {
+        struct bfs_worker *queue = &bfs_workers[(worker + i) % level->threads];
+
+        // Chunks are taken by moving the start of a queue forward, so the owner and the thieves never take the same one
+        while ((chunk = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED)) < queue->end)
+            k_hop_expand_chunk(level, &bfs_workers[worker], chunk);
+    }
+}
+
+// Function to compare two integers, for sorting the levels of a k-hop query
+static int compare_ints(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Function to collect the nodes within a number of hops of a given node
+int k_hop_collect(int id, int hops)
+{
+    struct id_slot *slot = id_index_find(id);
+    struct csr_graph *graph = csr_snapshot();
+
+    if (slot == NULL || graph == NULL || hops < 0)
+        return -1;
+
+    // No node is further than node_count - 1 hops, so a bigger number of hops is cut to it
+    if (hops > graph->node_count - 1)
+        hops = graph->node_count - 1;
+
+    if (!k_hop_reserve(graph, hops) || (bfs_worker_count == 0 && !thread_pool_start(1)))
+        return -1;
+
+    int words = graph->node_count / 64 + 1;
+
+    memset(k_hop_visited, 0, words * sizeof(unsigned long long));
+
+    int self = NODE_CSR_INDEX(slot->node);
+    int count = 1;
+
+    k_hop_visited[self / 64] |= 1ULL << (self % 64);
+    k_hop_nodes[0] = self;
+    k_hop_ends[0] = 1;
+
+    // Links of the nodes not reached yet, which is what a bottom-up step may have to look at
+    long long unexplored = graph->offsets[graph->node_count] - (graph->offsets[self + 1] - graph->offsets[self]);
+    int bottom_up = 0;
+    int level;
+
+    for (level = 1; level <= hops; level++)
+    {
+        int start = (level > 1) ? k_hop_ends[level - 2] : 0;
+        int end = k_hop_ends[level - 1];
+
+        if (start == end)
+            break; // Nothing left to reach
+
+        // The frontier is the last level found, k_hop_nodes[start] to k_hop_nodes[end - 1]
+        long long frontier_links = 0;
+
+        for (int i = start; i < end; i++)
+            frontier_links += graph->offsets[k_hop_nodes[i] + 1] - graph->offsets[k_hop_nodes[i]];
+
+        // Going bottom-up once the frontier has more links than a fraction of the nodes left, and back to top-down
+        // once the frontier shrinks to a small part of the graph
+        if (!bottom_up && frontier_links > unexplored / 14)
+            bottom_up = 1;
+        else if (bottom_up && (long long)(end - start) * 24 < graph->node_count)
+            bottom_up = 0;
+
+        struct k_hop_level step = {graph, start, end, bottom_up, 1};
+        int chunks;
+
+        if (bottom_up)
+        {
+            memset(k_hop_frontier, 0, words * sizeof(unsigned long long));
+
+            for (int i = start; i < end; i++)
+                k_hop_frontier[k_hop_nodes[i] / 64] |= 1ULL << (k_hop_nodes[i] % 64);
+
+            chunks = (graph->node_count + K_HOP_CHUNK_BOTTOM_UP - 1) / K_HOP_CHUNK_BOTTOM_UP;
+        }
+        else
+            chunks = (end - start + K_HOP_CHUNK_TOP_DOWN - 1) / K_HOP_CHUNK_TOP_DOWN;
+
+        // Small levels aren't worth waking the other threads for
+        if (bottom_up || frontier_links >= K_HOP_PARALLEL_LINKS)
+            step.threads = (chunks < bfs_pool.count) ? chunks : bfs_pool.count;
+
+        // Splitting the chunks evenly between the queues of the threads
+        for (int i = 0; i < step.threads; i++)
+        {
+            bfs_workers[i].next = (int)((long long)chunks * i / step.threads);
+            bfs_workers[i].end = (int)((long long)chunks * (i + 1) / step.threads);
+            bfs_workers[i].count = 0;
+            bfs_workers[i].links = 0;
+            bfs_workers[i].failed = 0;
+        }
+
+        thread_pool_run(k_hop_expand, &step, step.threads);
+
+        // Gathering the nodes found by every thread, and sorting them so that the result doesn't depend on the threads
+        int level_start = count;
+
+        for (int i = 0; i < step.threads; i++)
+        {
+            if (bfs_workers[i].failed)
+                return -1;
+
+            if (bfs_workers[i].count > 0)
+                memcpy(&k_hop_nodes[count], bfs_workers[i].found, bfs_workers[i].count * sizeof(int));
+
+            count += bfs_workers[i].count;
+            unexplored -= bfs_workers[i].links;
+        }
+
+        // Sorting the level unless it was found in order, by a single thread going bottom-up
+        if (!bottom_up || step.threads > 1)
+        {
+            if ((long long)(count - level_start) * 16 < words)
+                qsort(&k_hop_nodes[level_start], count - level_start, sizeof(int), compare_ints);
+            else
+            {
+                // A big level is sorted by setting it's bits in the frontier bitmap, which the next level rebuilds
+                // anyway, and reading them back in order
+                memset(k_hop_frontier, 0, words * sizeof(unsigned long long));
+
+                for (int i = level_start; i < count; i++)
+                    k_hop_frontier[k_hop_nodes[i] / 64] |= 1ULL << (k_hop_nodes[i] % 64);
+
+                count = level_start;
+
+                for (int word = 0; word < words; word++)
+                {
+                    for (unsigned long long bits = k_hop_frontier[word]; bits != 0; bits &= bits - 1)
+                        k_hop_nodes[count++] = word * 64 + __builtin_ctzll(bits);
+                }
+            }
+        }
+
+        k_hop_ends[level] = count;
+    }
+
+    // The levels that weren't reached are empty
+    for (; level <= hops; level++)
+        k_hop_ends[level] = count;
+
+    return count - 1;
+}
+
+// Function to make room in the shortest path buffers for a graph
+static int path_reserve(struct csr_graph *graph)
+{
+    if (path_capacity >= graph->node_count)
+        return 1;
+
+    int *parents = (int *)realloc(path_parents, graph->node_count * sizeof(int));
+
+    if (parents != NULL)
+        path_parents = parents;
+
+    int *depths = (int *)realloc(path_depths, graph->node_count * sizeof(int));
+
+    if (depths != NULL)
+        path_depths = depths;
+
+    int *queue = (int *)realloc(path_queue, graph->node_count * sizeof(int));
+
+    if (queue != NULL)
+        path_queue = queue;
+
+    int *nodes = (int *)realloc(path_nodes, graph->node_count * sizeof(int));
+
+    if (nodes != NULL)
+        path_nodes = nodes;
+
+    if (parents == NULL || depths == NULL || queue == NULL || nodes == NULL)
+        return 0;
+
+    path_capacity = graph->node_count;
+
+    return 1;
+}
+
+// Function to find the shortest path between two nodes
+int shortest_path(int from, int to)
+{
+    struct id_slot *from_slot = id_index_find(from);
+    struct id_slot *to_slot = id_index_find(to);
+    struct csr_graph *graph = csr_snapshot();
+
+    if (from_slot == NULL || to_slot == NULL || graph == NULL || !path_reserve(graph))
+        return -2;
+
+    int source = NODE_CSR_INDEX(from_slot->node);
+    int target = NODE_CSR_INDEX(to_slot->node);
+
+    path_nodes[0] = source;
+    path_length = 0;
+
+    if (source == target)
+        return 0;
+
+    // Each side stamps the nodes it reaches with it's own epoch, so meeting the other side is a single comparison
+    csr_new_epoch(graph);
+    unsigned int forward = graph->epoch;
+    csr_new_epoch(graph);
+    unsigned int backward = graph->epoch;
+
+    // The queues of the two sides share a buffer, the forward side growing up from the start and the backward one down
+    // from the end. No node is in both, so they never overlap
+    int forward_start = 0, forward_end = 1;
+    int backward_start = graph->node_count - 1, backward_end = graph->node_count - 2;
+
+    path_queue[0] = source;
+    path_queue[graph->node_count - 1] = target;
+
+    graph->stamps[source] = forward;
+    graph->stamps[target] = backward;
+    path_parents[source] = path_parents[target] = -1;
+    path_depths[source] = path_depths[target] = 0;
+
+    long long forward_links = graph->offsets[source + 1] - graph->offsets[source];
+    long long backward_links = graph->offsets[target + 1] - graph->offsets[target];
+
+    int best = -1, best_near = -1, best_far = -1;
+
+    while (forward_start < forward_end && backward_start > backward_end)
+    {
+        // Expanding a whole level of the side whose frontier has fewer links
+        int is_forward = forward_links <= backward_links;
+        unsigned int own = is_forward ? forward : backward;
+        unsigned int other = is_forward ? backward : forward;
+
+        int start = is_forward ? forward_start : backward_start;
+        int end = is_forward ? forward_end : backward_end;
+        int step = is_forward ? 1 : -1;
+        int tail = end;
+        long long links = 0;
+
+        for (int i = start; i != end; i += step)
+        {
+            int node = path_queue[i];
+
+            for (int j = graph->offsets[node]; j < graph->offsets[node + 1]; j++)
+            {
+                int neighbour = graph->neighbors[j];
+
+                if (graph->stamps[neighbour] == other)
+                {
+                    // The two sides meet, the rest of the level is still looked at for a shorter meeting
+                    int length = path_depths[node] + 1 + path_depths[neighbour];
+
+                    if (best == -1 || length < best)
+                    {
+                        best = length;
+                        best_near = is_forward ? node : neighbour;
+                        best_far = is_forward ? neighbour : node;
+                    }
+                }
+                else if (graph->stamps[neighbour] != own)
+                {
+                    graph->stamps[neighbour] = own;
+                    path_parents[neighbour] = node;
+                    path_depths[neighbour] = path_depths[node] + 1;
+                    path_queue[tail] = neighbour;
+                    tail += step;
+                    links += graph->offsets[neighbour + 1] - graph->offsets[neighbour];
+                }
+            }
+        }
+
+        if (best != -1)
+            break;
+
+        if (is_forward)
+        {
+            forward_start = forward_end;
+            forward_end = tail;
+            forward_links = links;
+        }
+        else
+        {
+            backward_start = backward_end;
+            backward_end = tail;
+            backward_links = links;
+        }
+    }
+
+    if (best == -1)
+        return -1; // Not connected
+
+    // The forward half is walked back from the meeting point to the source, and the backward half on to the target
+    path_length = best;
+
+    for (int node = best_near, i = path_depths[best_near]; node != -1; node = path_parents[node], i--)
+        path_nodes[i] = node;
+
+    for (int node = best_far, i = path_depths[best_near] + 1; node != -1; node = path_parents[node], i++)
+        path_nodes[i] = node;
+
+    return path_length;
+}
+
+// Function to print the shortest path between two nodes
+void print_shortest_path(int from, int to)
+{
+    int length = shortest_path(from, to);
+
+    if (length == -2)
+    {
+        printf("No such node exists\n");
+        return;
+    }
+
+    if (length == -1)
+    {
+        printf("The nodes aren't connected\n\n");
+        return;
+    }
+
+    printf("The shortest path is %d link(s) long:- \n\n", length);
+
+    for (int i = 0; i <= length; i++)
+    {
+        void *node = membership_graph.nodes[path_nodes[i]];
+
+        printf("%s%s (%s, ID %d)", i == 0 ? "" : " -> ", NODE_NAME(node), kind_info[NODE_KIND(node)].type, NODE_ID(node));
+    }
+
+    printf("\n\n");
+}
+
+// Function to find the root of the set of an element, halving the path to it on the way
+static int union_find_root(struct union_find *sets, int element)
+{
+    while (sets->parents[element] != element)
+    {
+        sets->parents[element] = sets->parents[sets->parents[element]];
+        element = sets->parents[element];
+    }
+
+    return element;
+}
+
+// Function to join the sets of two elements, the smaller set going under the root of the bigger one
+static void union_find_join(struct union_find *sets, int a, int b)
+{
+    a = union_find_root(sets, a);
+    b = union_find_root(sets, b);
+
+    if (a == b)
+        return;
+
+    if (sets->sizes[a] < sets->sizes[b])
+    {
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+
+    sets->parents[b] = a;
+    sets->sizes[a] += sets->sizes[b];
+    sets->components--;
+}
+
+// Function to make room in the union-find for a given number of elements
+static int union_find_reserve(struct union_find *sets, int count)
+{
+    if (sets->capacity >= count)
+        return 1;
+
+    int new_capacity = sets->capacity ? sets->capacity : 64;
+
+    while (new_capacity < count)
+        new_capacity *= 2;
+
+    int *parents = (int *)realloc(sets->parents, new_capacity * sizeof(int));
+
+    if (parents == NULL)
+        return 0;
+
+    sets->parents = parents;
+
+    int *sizes = (int *)realloc(sets->sizes, new_capacity * sizeof(int));
+
+    if (sizes == NULL)
+        return 0;
+
+    sets->sizes = sizes;
+    sets->capacity = new_capacity;
+
+    return 1;
+}
+
+// Function to give a new node an element of it's own in the connected components
+void components_add_node(void *node)
+{
+    struct union_find *sets = &node_components;
+
+    if (sets->dirty)
+        return; // The node is counted when the components are built again
+
+    if (!union_find_reserve(sets, sets->count + 1))
+    {
+        sets->dirty = 1;
+        return;
+    }
+
+    sets->parents[sets->count] = sets->count;
+    sets->sizes[sets->count] = 1;
+    sets->components++;
+
+    NODE_COMPONENT(node) = sets->count++;
+}
+
+// Function to join the components of two nodes that were just linked
+void components_add_link(void *a, void *b)
+{
+    if (!node_components.dirty)
+        union_find_join(&node_components, NODE_COMPONENT(a), NODE_COMPONENT(b));
+}
+
+// Function to mark the connected components as no longer matching the graph
+void components_mark_dirty()
+{
+    node_components.dirty = 1;
+}
+
+// Function to build the connected components again from the CSR snapshot
+int components_rebuild()
+{
+    struct union_find *sets = &node_components;
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL || !union_find_reserve(sets, graph->node_count))
+        return 0;
+
+    // Every node starts in a set of it's own, the elements of the deleted nodes are dropped
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        sets->parents[i] = i;
+        sets->sizes[i] = 1;
+        NODE_COMPONENT(graph->nodes[i]) = i;
+    }
+
+    sets->count = graph->node_count;
+    sets->components = graph->node_count;
+
+    // Every link is stored at both it's ends, so it is enough to join from the end with the smaller index
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        for (int j = graph->offsets[i]; j < graph->offsets[i + 1]; j++)
+        {
+            if (graph->neighbors[j] > i)
+                union_find_join(sets, i, graph->neighbors[j]);
+        }
+    }
+
+    sets->dirty = 0;
+
+    return 1;
+}
+
+// Function to tell if two nodes are connected
+int nodes_connected(int a, int b)
+{
+    struct id_slot *slot_a = id_index_find(a);
+    struct id_slot *slot_b = id_index_find(b);
+
+    if (slot_a == NULL || slot_b == NULL || (node_components.dirty && !components_rebuild()))
+        return -1;
+
+    return union_find_root(&node_components, NODE_COMPONENT(slot_a->node)) == union_find_root(&node_components, NODE_COMPONENT(slot_b->node));
+}
+
+// Function to compare two components by their size, the bigger one first, and then by their smallest id
+static int compare_components(const void *a, const void *b)
+{
+    const struct component_info *x = (const struct component_info *)a;
+    const struct component_info *y = (const struct component_info *)b;
+
+    if (x->size != y->size)
+        return (x->size < y->size) - (x->size > y->size);
+
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Function to list the connected components
+int components_collect()
+{
+    struct union_find *sets = &node_components;
+
+    if (sets->dirty && !components_rebuild())
+        return -1;
+
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL)
+        return -1;
+
+    if (found_components_capacity < sets->components)
+    {
+        struct component_info *temp = (struct component_info *)realloc(found_components, sets->components * sizeof(struct component_info));
+
+        if (temp == NULL)
+            return -1;
+
+        found_components = temp;
+        found_components_capacity = sets->components;
+    }
+
+    // Position of the component of every root in found_components[]
+    int *positions = (int *)malloc((sets->count + 1) * sizeof(int));
+
+    if (positions == NULL)
+        return -1;
+
+    memset(positions, -1, sets->count * sizeof(int));
+
+    int count = 0;
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        void *node = graph->nodes[i];
+        int root = union_find_root(sets, NODE_COMPONENT(node));
+
+        if (positions[root] == -1)
+        {
+            positions[root] = count;
+            found_components[count].id = NODE_ID(node);
+            found_components[count].size = sets->sizes[root];
+            count++;
+        }
+        else if (NODE_ID(node) < found_components[positions[root]].id)
+            found_components[positions[root]].id = NODE_ID(node);
+    }
+
+    free(positions);
+
+    if (count > 1)
+        qsort(found_components, count, sizeof(struct component_info), compare_components);
+
+    return count;
+}
+
+// Function to print the connected components
+void print_components()
+{
+    int count = components_collect();
+
+    if (count < 0)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return;
+    }
+
+    if (count == 0)
+    {
+        printf("There are no nodes\n\n");
+        return;
+    }
+
+    printf("There are %d connected component(s):- \n\n", count);
+
+    for (int i = 0; i < count; i++)
+    {
+        void *node = id_index_find(found_components[i].id)->node;
+
+        printf("%d node(s) along with %s (%s, ID %d)\n", found_components[i].size, NODE_NAME(node), kind_info[NODE_KIND(node)].type, found_components[i].id);
+    }
+
+    printf("\n");
+}
+
+// Function run by every thread for a phase of a PageRank iteration, over it's own range of nodes
+static void pagerank_step(int worker, void *arg)
+{
+    struct pagerank_state *state = (struct pagerank_state *)arg;
+
+    if (worker >= state->threads)
+        return;
+
+    int start = (int)((long long)state->node_count * worker / state->threads);
+    int end = (int)((long long)state->node_count * (worker + 1) / state->threads);
+    double sum = 0;
+
+    if (state->phase == 0)
+    {
+        // Dividing the score of every node between it's links, the nodes without any are summed up instead
+        for (int node = start; node < end; node++)
+        {
+            int links = state->offsets[node + 1] - state->offsets[node];
+
+            if (links == 0)
+            {
+                sum += state->current[node];
+                state->contributions[node] = 0;
+            }
+            else
+                state->contributions[node] = state->current[node] / links;
+        }
+    }
+    else
+    {
+        // Pulling the contributions of the neighbours, and summing how much the scores changed
+        for (int node = start; node < end; node++)
+        {
+            double score = 0;
+
+            for (int j = state->offsets[node]; j < state->offsets[node + 1]; j++)
+                score += state->contributions[state->neighbors[j]];
+
+            score = state->base + state->damping * score;
+
+            sum += (score > state->current[node]) ? score - state->current[node] : state->current[node] - score;
+            state->next[node] = score;
+        }
+    }
+
+    state->partials[worker] = sum;
+}
+
+// Function to iterate PageRank till the scores change by less than the tolerance, returns the iterations run
+static int pagerank_iterate(struct pagerank_state *state, double tolerance, int max_iterations)
+{
+    int iteration = 0;
+
+    while (iteration < max_iterations)
+    {
+        double dangling = 0, change = 0;
+
+        state->phase = 0;
+        thread_pool_run(pagerank_step, state, state->threads);
+
+        for (int i = 0; i < state->threads; i++)
+            dangling += state->partials[i];
+
+        // Every node gets the jump to a random node, along with it's share of the scores of the nodes without links
+        state->base = (1 - state->damping + state->damping * dangling) / state->node_count;
+
+        state->phase = 1;
+        thread_pool_run(pagerank_step, state, state->threads);
+
+        for (int i = 0; i < state->threads; i++)
+            change += state->partials[i];
+
+        double *temp = state->current;
+        state->current = state->next;
+        state->next = temp;
+
+        iteration++;
+
+        if (change < tolerance)
+            break;
+    }
+
+    return iteration;
+}
+
+// Function to set up the starting scores of a PageRank computation from the last one
+static void pagerank_start(double *scores, int node_count)
+{
+    double total = 0;
+
+    // Nodes never scored, such as new ones, start with an even share
+    for (int i = 0; i < node_count; i++)
+    {
+        if (scores[i] <= 0)
+            scores[i] = 1.0 / node_count;
+
+        total += scores[i];
+    }
+
+    for (int i = 0; i < node_count; i++)
+        scores[i] /= total;
+}
+
+// Function to score the influence of every node with PageRank
+int pagerank_compute(double damping, double tolerance, int max_iterations)
+{
+    // A computation running in the background would hand out older scores once it is done
+    pagerank_poll(1);
+
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL)
+        return -1;
+
+    if (graph->node_count == 0)
+        return 0;
+
+    if (pagerank_capacity < graph->node_count)
+    {
+        double *temp = (double *)realloc(pagerank_vectors, 3 * (size_t)graph->node_count * sizeof(double));
+
+        if (temp == NULL)
+            return -1;
+
+        pagerank_vectors = temp;
+        pagerank_capacity = graph->node_count;
+    }
+
+    if (pagerank_partials_capacity < bfs_pool.count)
+    {
+        double *temp = (double *)realloc(pagerank_partials, bfs_pool.count * sizeof(double));
+
+        if (temp == NULL)
+            return -1;
+
+        pagerank_partials = temp;
+        pagerank_partials_capacity = bfs_pool.count;
+    }
+
+    struct pagerank_state state = {graph->node_count, graph->offsets, graph->neighbors, pagerank_vectors,
+                                   pagerank_vectors + graph->node_count, pagerank_vectors + 2 * graph->node_count,
+                                   damping, 0, pagerank_partials, bfs_pool.count, 0};
+
+    // Small graphs aren't worth waking the other threads for
+    if (graph->node_count + graph->edge_count < K_HOP_PARALLEL_LINKS)
+        state.threads = 1;
+
+    // Starting from the scores the nodes already have
+    for (int i = 0; i < graph->node_count; i++)
+        state.current[i] = NODE_SCORE(graph->nodes[i]);
+
+    pagerank_start(state.current, graph->node_count);
+
+    int iterations = pagerank_iterate(&state, tolerance, max_iterations);
+
+    for (int i = 0; i < graph->node_count; i++)
+        NODE_SCORE(graph->nodes[i]) = state.current[i];
+
+    pagerank_ready = 1;
+
+    return iterations;
+}
+
+// Function run by the thread of a background PageRank computation
+static void *pagerank_background_main(void *arg)
+{
+    struct pagerank_job *job = (struct pagerank_job *)arg;
+
+    job->iterations = pagerank_iterate(&job->state, job->tolerance, job->max_iterations);
+
+    __atomic_store_n(&job->done, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+// Function to free the copies made for a background PageRank computation
+static void pagerank_job_free(struct pagerank_job *job)
+{
+    free((void *)job->state.offsets);
+    free((void *)job->state.neighbors);
+    free(job->vectors);
+    free(job->state.partials);
+    free(job->ids);
+
+    memset(job, 0, sizeof(struct pagerank_job));
+}
+
+// Function to start scoring the nodes with PageRank in the background
+int pagerank_refresh(double damping, double tolerance, int max_iterations)
+{
+    struct pagerank_job *job = &pagerank_background;
+
+    pagerank_poll(0);
+
+    if (job->running)
+        return 0;
+
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL || graph->node_count == 0)
+        return 0;
+
+    int node_count = graph->node_count;
+
+    // Copying everything the thread reads, the snapshot is rebuilt as soon as the graph changes
+    int *offsets = (int *)malloc((node_count + 1) * sizeof(int));
+    int *neighbors = (int *)malloc((graph->edge_count + 1) * sizeof(int));
+    double *vectors = (double *)malloc(3 * (size_t)node_count * sizeof(double));
+    double *partials = (double *)malloc(sizeof(double));
+    int *ids = (int *)malloc(node_count * sizeof(int));
+
+    job->state.offsets = offsets;
+    job->state.neighbors = neighbors;
+    job->state.current = vectors;
+    job->state.partials = partials;
+    job->vectors = vectors;
+    job->ids = ids;
+
+    if (offsets == NULL || neighbors == NULL || vectors == NULL || partials == NULL || ids == NULL)
+    {
+        pagerank_job_free(job);
+        return 0;
+    }
+
+    memcpy(offsets, graph->offsets, (node_count + 1) * sizeof(int));
+    memcpy(neighbors, graph->neighbors, graph->edge_count * sizeof(int));
+
+    for (int i = 0; i < node_count; i++)
+    {
+        ids[i] = NODE_ID(graph->nodes[i]);
+        vectors[i] = NODE_SCORE(graph->nodes[i]);
+    }
+
+    pagerank_start(vectors, node_count);
+
+    // The pool belongs to the main thread, so the background computation runs on it's own thread alone
+    job->state.node_count = node_count;
+    job->state.next = vectors + node_count;
+    job->state.contributions = vectors + 2 * (size_t)node_count;
+    job->state.damping = damping;
+    job->state.threads = 1;
+    job->tolerance = tolerance;
+    job->max_iterations = max_iterations;
+    job->done = 0;
+
+    if (pthread_create(&job->thread, NULL, pagerank_background_main, job) != 0)
+    {
+        pagerank_job_free(job);
+        return 0;
+    }
+
+    job->running = 1;
+
+    return 1;
+}
+
+// Function to hand the scores found in the background to the nodes, if they are ready
+int pagerank_poll(int wait)
+{
+    struct pagerank_job *job = &pagerank_background;
+
+    if (!job->running || (!wait && !__atomic_load_n(&job->done, __ATOMIC_ACQUIRE)))
+        return 0;
+
+    pthread_join(job->thread, NULL);
+
+    // Nodes deleted since the copy was made are skipped
+    for (int i = 0; i < job->state.node_count; i++)
+    {
+        struct id_slot *slot = id_index_find(job->ids[i]);
+
+        if (slot != NULL)
+            NODE_SCORE(slot->node) = job->state.current[i];
+    }
+
+    pagerank_ready = 1;
+    pagerank_job_free(job);
+
+    return 1;
+}
+
+// Function to print the number of nodes within a number of hops of a node
+void print_k_hop(int id, int hops)
+{
+    if (hops < 0)
+    {
+        printf("Invalid number of hops\n\n");
+        return;
+    }
+
+    int count = k_hop_collect(id, hops);
+
+    if (count < 0)
+    {
+        printf(id_index_find(id) == NULL ? "No such node exists\n" : "Memory allocation failed. Please try again\n");
+        return;
+    }
+
+    printf("The number of nodes reached are:- \n\n");
+
+    for (int level = 1; level <= hops && k_hop_ends[level - 1] <= count; level++)
+        printf("%d-hop :- %d\n", level, k_hop_ends[level] - k_hop_ends[level - 1]);
+
+    printf("\nWithin %d hops :- %d\n\n", hops, count);
+}
+
+// Function to add a chunk to the end of a post log, creating the log if needed
+static struct post_chunk *post_log_add_chunk(struct post_log **log, struct post_chunk *chunk)
+{
+    if (*log == NULL && (*log = (struct post_log *)calloc(1, sizeof(struct post_log))) == NULL)
+        return NULL;
+
+    chunk->next = NULL;
+    chunk->prev = (*log)->tail;
+
+    if ((*log)->tail == NULL)
+        (*log)->head = chunk;
+    else
+        (*log)->tail->next = chunk;
+
+    (*log)->tail = chunk;
+
+    return chunk;
+}
+
+// Function to add a post to the end of a post log
+int post_log_append(struct post_log **log, char *post, long long time)
+{
+    size_t size = strlen(post) + 1;
+    struct post_chunk *tail = (*log == NULL) ? NULL : (*log)->tail;
+
+    // Keeping the posts in order of time even if the clock went back
+    if (tail != NULL && tail->count > 0 && time < tail->times[tail->count - 1])
+        time = tail->times[tail->count - 1];
+
+    if (tail == NULL || tail->capacity - tail->used < size)
+    {
+        // Every chunk is twice as big as the one before it, so a node with many posts only has a few chunks
+        size_t capacity = (tail == NULL) ? POST_CHUNK_MIN : tail->capacity * 2;
+
+        if (capacity > POST_CHUNK_MAX)
+            capacity = POST_CHUNK_MAX;
+
+        if (capacity < size)
+            capacity = size;
+
+        tail = (struct post_chunk *)malloc(sizeof(struct post_chunk) + capacity);
+
+        if (tail == NULL)
+            return -1;
+
+        tail->data = (char *)(tail + 1);
+        tail->used = 0;
+        tail->capacity = capacity;
+        tail->count = 0;
+        tail->times = NULL;
+        tail->times_capacity = 0;
+
+        if (post_log_add_chunk(log, tail) == NULL)
+        {
+            free(tail);
+            return -1;
+        }
+    }
+
+    if (tail->count == tail->times_capacity)
+    {
+        int new_capacity = tail->times_capacity ? tail->times_capacity * 2 : 8;
+        long long *times = (long long *)realloc(tail->times, new_capacity * sizeof(long long));
+
+        if (times == NULL)
+            return -1;
+
+        tail->times = times;
+        tail->times_capacity = new_capacity;
+    }
+
+    memcpy(tail->data + tail->used, post, size);
+    tail->used += size;
+    tail->times[tail->count++] = time;
+
+    (*log)->count++;
+    (*log)->bytes += size;
+
+    return 1;
+}
+
+// Function to take the latest post back off the end of a post log
+void post_log_drop_last(struct post_log **log)
+{
+    struct post_chunk *tail = (*log)->tail;
+
+    // The latest post ends the data of the tail, and starts after the '\0' of the one before it
+    size_t start = tail->used - 1;
+
+    while (start > 0 && tail->data[start - 1] != '\0')
+        start--;
+
+    (*log)->bytes -= tail->used - start;
+    (*log)->count--;
+
+    tail->used = start;
+    tail->count--;
+
+    if (tail->count > 0)
+        return;
+
+    // The chunk was made for the post, so it goes with it, and so does the log if that was the first post
+    (*log)->tail = tail->prev;
+
+    if (tail->prev == NULL)
+        (*log)->head = NULL;
+    else
+        tail->prev->next = NULL;
+
+    free(tail->times);
+    free(tail);
+
+    if ((*log)->head == NULL)
+    {
+        free(*log);
+        *log = NULL;
+    }
+}
+
+// Function to add posts stored one after the other to a post log, without copying them
+int post_log_map(struct post_log **log, char *posts, int count, size_t bytes, long long *times)
+{
+    struct post_chunk *chunk = (struct post_chunk *)malloc(sizeof(struct post_chunk));
+
+    if (chunk == NULL)
+        return -1;
+
+    chunk->data = posts;
+    chunk->used = bytes;
+    chunk->capacity = bytes; // Full, so the next post goes to a chunk of it's own
+    chunk->count = count;
+    chunk->times = times;
+    chunk->times_capacity = count;
+
+    if (post_log_add_chunk(log, chunk) == NULL)
+    {
+        free(chunk);
+        return -1;
+    }
+
+    (*log)->count += count;
+    (*log)->bytes += bytes;
+
+    return 1;
+}
+
+// Function to free a post log along with it's chunks
+void post_log_free(struct post_log *log)
+{
+    if (log == NULL)
+        return;
+
+    struct post_chunk *chunk = log->head;
+
+    while (chunk != NULL)
+    {
+        struct post_chunk *next = chunk->next;
+
+        release_memory(chunk->times);
+        free(chunk); // The data is either part of the same allocation or of a mapped snapshot
+        chunk = next;
+    }
+
+    free(log);
+}
+
+// Function to start reading a post log from the post numbered first
+void post_log_seek(struct post_log *log, int first, struct post_cursor *cursor)
+{
+    cursor->chunk = (log == NULL) ? NULL : log->head;
+    cursor->offset = 0;
+    cursor->index = 0;
+
+    // Skipping the whole chunks before the post
+    while (cursor->chunk != NULL && first >= cursor->chunk->count)
+    {
+        first -= cursor->chunk->count;
+        cursor->chunk = cursor->chunk->next;
+    }
+
+    for (; cursor->chunk != NULL && first > 0 && cursor->offset < cursor->chunk->used; first--)
+    {
+        cursor->offset += strlen(cursor->chunk->data + cursor->offset) + 1;
+        cursor->index++;
+    }
+}
+
+// Function to read the next post of a post log
+char *post_log_next(struct post_cursor *cursor)
+{
+    while (cursor->chunk != NULL && cursor->offset >= cursor->chunk->used)
+    {
+        cursor->chunk = cursor->chunk->next;
+        cursor->offset = 0;
+        cursor->index = 0;
+    }
+
+    if (cursor->chunk == NULL)
+        return NULL;
+
+    char *post = cursor->chunk->data + cursor->offset;
+    cursor->offset += strlen(post) + 1;
+    cursor->index++;
+
+    return post;
+}
+
+// Function to set a cursor right after the latest post of a post log
+void post_log_seek_end(struct post_log *log, struct post_cursor *cursor)
+{
+    cursor->chunk = (log == NULL) ? NULL : log->tail;
+    cursor->offset = (cursor->chunk == NULL) ? 0 : cursor->chunk->used;
+    cursor->index = (cursor->chunk == NULL) ? 0 : cursor->chunk->count;
+}
+
+// Function to read the post before a cursor, going back from the latest post
+char *post_log_prev(struct post_cursor *cursor, long long *time)
+{
+    while (cursor->chunk != NULL && cursor->index == 0)
+    {
+        cursor->chunk = cursor->chunk->prev;
+        cursor->offset = (cursor->chunk == NULL) ? 0 : cursor->chunk->used;
+        cursor->index = (cursor->chunk == NULL) ? 0 : cursor->chunk->count;
+    }
+
+    if (cursor->chunk == NULL)
+        return NULL;
+
+    // The post ends with the '\0' right before the offset, and starts after the '\0' before that one
+    char *data = cursor->chunk->data;
+    size_t start = cursor->offset - 1;
+
+    while (start > 0 && data[start - 1] != '\0')
+        start--;
+
+    cursor->offset = start;
+    cursor->index--;
+    *time = cursor->chunk->times[cursor->index];
+
+    return data + start;
+}
+
+// Function to add a post made at a given time to the content of a node
+int post_content_at(int id, char *new_content, long long time)
+{
+    // Finding the node with the given (unique) id through the ID index
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return 0;                                   // No node exists with the given id
+
+    // The post is copied to the end of the node's post log, whatever was posted before stays where it is
+    if (post_log_append(NODE_FIELD(slot->node, struct post_log *, posts), new_content, time) < 0)
+        return -1;
+
+    if (!word_index_add(id, new_content) || !trigram_index_add(id, new_content))
+    {
+        post_log_drop_last(NODE_FIELD(slot->node, struct post_log *, posts));
+
+        // The entries added before the failure can't be told apart from the ones the node already had, so both
+        // indexes are emptied and built again from the contents by the next search, through index_require()
+        word_index_clear(&all_Words);
+        word_index_clear(&all_Trigrams);
+        pending_indexes |= INDEX_WORDS;
+
+        return -1;
+    }
+
+    content_arena_mark_stale();
+
+    // Flagging the post right away if it has a blocked phrase
+    blocklist_check(id, new_content);
+
+    wal_record("post-at|%d|%lld|%s", id, time, new_content);
+
+    return 1;
+}
+
+// Function to add a post to the content of a node, made now
+int post_content(int id, char *new_content)
+{
+    return post_content_at(id, new_content, (long long)time(NULL));
+}
+
+// Function to tell if a feed source has to come before another one, by the time of it's post
+static int feed_before(struct feed_source *a, struct feed_source *b)
+{
+    return a->time > b->time || (a->time == b->time && a->id < b->id);
+}
+
+// Function to move a source down the feed heap till it comes before both it's children
+static void feed_sift_down(int count, int pos)
+{
+    struct feed_source moving = feed_heap[pos];
+
+    while (2 * pos + 1 < count)
+    {
+        int child = 2 * pos + 1;
+
+        if (child + 1 < count && feed_before(&feed_heap[child + 1], &feed_heap[child]))
+            child++;
+
+        if (!feed_before(&feed_heap[child], &moving))
+            break;
+
+        feed_heap[pos] = feed_heap[child];
+        pos = child;
+    }
+
+    feed_heap[pos] = moving;
+}
+
+// Function to collect the latest posts of the one-hop nodes of a node, by merging their post logs from the end
+int feed_collect(int id, int count)
+{
+    struct id_slot *slot = id_index_find(id);
+    struct csr_graph *graph = csr_snapshot();
+
+    if (slot == NULL || graph == NULL)
+        return -1;
+
+    int self = NODE_CSR_INDEX(slot->node);
+    int degree = graph->offsets[self + 1] - graph->offsets[self];
+
+    if (feed_heap_capacity < degree + 1)
+    {
+        struct feed_source *temp = (struct feed_source *)realloc(feed_heap, (degree + 1) * sizeof(struct feed_source));
+
+        if (temp == NULL)
+        {
+            printf("Memory allocation failed. Please try again\n");
+            return -1;
+        }
+
+        feed_heap = temp;
+        feed_heap_capacity = degree + 1;
+    }
+
+    // A node linked to this one more than once is only merged once
+    csr_new_epoch(graph);
+
+    int heap_count = 0;
+
+    for (int i = graph->offsets[self]; i < graph->offsets[self + 1]; i++)
+    {
+        int neighbor = graph->neighbors[i];
+        struct feed_source *source = &feed_heap[heap_count];
+
+        if (graph->stamps[neighbor] == graph->epoch)
+            continue;
+
+        graph->stamps[neighbor] = graph->epoch;
+
+        post_log_seek_end(NODE_POSTS(graph->nodes[neighbor]), &source->cursor);
+
+        if ((source->post = post_log_prev(&source->cursor, &source->time)) == NULL)
+            continue; // Nothing posted
+
+        source->id = NODE_ID(graph->nodes[neighbor]);
+        heap_count++;
+    }
+
+    for (int i = heap_count / 2 - 1; i >= 0; i--)
+        feed_sift_down(heap_count, i);
+
+    // The latest post left is always on top, and is replaced by the one it's node made before it
+    int taken = 0;
+
+    while (taken < count && heap_count > 0)
+    {
+        if (taken == feed_capacity)
+        {
+            int new_capacity = feed_capacity ? feed_capacity * 2 : 64;
+            struct feed_item *temp = (struct feed_item *)realloc(feed_items, new_capacity * sizeof(struct feed_item));
+
+            if (temp == NULL)
+            {
+                printf("Memory allocation failed. Please try again\n");
+                return -1;
+            }
+
+            feed_items = temp;
+            feed_capacity = new_capacity;
+        }
+
+        struct feed_source *top = &feed_heap[0];
+
+        feed_items[taken].id = top->id;
+        feed_items[taken].time = top->time;
+        feed_items[taken].post = top->post;
+        taken++;
+
+        if ((top->post = post_log_prev(&top->cursor, &top->time)) == NULL)
+            *top = feed_heap[--heap_count]; // The node has nothing older
+
+        if (heap_count > 0)
+            feed_sift_down(heap_count, 0);
+    }
+
+    return taken;
+}
+
+// Function to print the feed of a node
+void print_feed(int id, int count)
+{
+    count = feed_collect(id, count);
+
+    if (count < 0)
+    {
+        printf("No such node exists\n");
+        return;
+    }
+
+    if (count == 0)
+    {
+        printf("There are no posts by the 1-hop nodes\n\n");
+        return;
+    }
+
+    printf("The latest posts of the 1-hop nodes are:- \n\n");
+
+    for (int i = 0; i < count; i++)
+    {
+        void *node = id_index_find(feed_items[i].id)->node;
+        time_t when = (time_t)feed_items[i].time;
+        char when_text[40];
+
+        strftime(when_text, sizeof(when_text), "%d/%m/%Y %H:%M:%S", localtime(&when));
+
+        printf("%s (ID %d) at %s\n%s\n\n", NODE_NAME(node), feed_items[i].id, when_text, feed_items[i].post);
+    }
+}
+
+// Function to print the places nearest to a node
+void print_places_near(int id, int kind, int count)
+{
+    struct id_slot *slot = id_index_find(id);
+    double x, y;
+
+    if (slot == NULL)
+    {
+        printf("No such node exists\n");
+        return;
+    }
+
+    if (!node_position(slot->node, &x, &y))
+    {
+        printf("The node with ID %d has no coordinates\n", id);
+        return;
+    }
+
+    count = places_nearest(kind, x, y, count, id);
+
+    if (count == 0)
+    {
+        printf("There are no such nodes nearby\n\n");
+        return;
+    }
+
+    printf("The nearest nodes are:- \n\n");
+
+    for (int i = 0; i < count; i++)
+        print_node(id_index_find(found_places[i].id)->node);
+}
+
+// Function to add content to already existing content
+void add_content()
+{
+    printf("\nEnter the ID of the node you want to modify: ");
+    int id;
+    scanf("%d%c", &id, &throwaway);
+
+    printf("\nEnter the content you want to add\n");
+    char *new_content = content_input();
+
+    if (new_content == NULL)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return;
+    }
+
+    int flagged = flagged_posts.count;
+    int result = post_content(id, new_content);
+
+    if (result == 0)
+        printf("No such node exists\n");            // No node exists with the given id
+    else if (result < 0)
+        printf("\n********* Error!! Memory allocation failed ********\n");
+    else
+        printf("\n******** New content successfully added ********\n");
+
+    // Warning about the blocked phrases the post has
+    for (int i = flagged; i < flagged_posts.count; i++)
+        printf("The post has the blocked phrase \"%s\"\n", blocklist.patterns[flagged_posts.matches[i].pattern]);
+
+    // Free the memory allocated for new_content
+    free(new_content);
+}
+
+// Function to compare two posting lists by their length, for intersecting the shortest first
+static int compare_postings(const void *a, const void *b)
+{
+    const struct word_entry *x = *(const struct word_entry **)a;
+    const struct word_entry *y = *(const struct word_entry **)b;
+
+    return (x->count > y->count) - (x->count < y->count);
+}
+
+// Function to make room in found_nodes[] for the given number of nodes
+static int found_reserve(int count)
+{
+    if (found_capacity >= count)
+        return 1;
+
+    void **temp = (void **)realloc(found_nodes, count * sizeof(void *));
+
+    if (temp == NULL)
+        return 0;
+
+    found_nodes = temp;
+    found_capacity = count;
+
+    return 1;
+}
+
+// Function to compare two nodes by their position in the global lists
+static int compare_csr_index(const void *a, const void *b)
+{
+    int x = NODE_CSR_INDEX(*(void **)a);
+    int y = NODE_CSR_INDEX(*(void **)b);
+
+    return (x > y) - (x < y);
+}
+
+// Function to intersect the posting lists of some words (or trigrams) of an index, returns the ids of the nodes using
+// all of them
+static int intersect_words(struct word_index *index, char (*words)[WORD_LIMIT + 1], int word_count, int **ids)
+{
+    struct word_entry **entries = (struct word_entry **)malloc(word_count * sizeof(struct word_entry *));
+
+    *ids = NULL;
+
+    if (entries == NULL)
+        return -1;
+
+    for (int i = 0; i < word_count; i++)
+    {
+        entries[i] = word_index_find(index, words[i]);
+
+        if (entries[i] == NULL)
+        {
+            free(entries);
+            return 0; // No node uses the word, so none can use all of them
+        }
+    }
+
+    // Starting from the shortest list, every other list can only remove ids
+    qsort(entries, word_count, sizeof(struct word_entry *), compare_postings);
+
+    int count = entries[0]->count;
+    *ids = (int *)malloc((count + 1) * sizeof(int));
+
+    if (*ids == NULL)
+    {
+        free(entries);
+        return -1;
+    }
+
+    memcpy(*ids, entries[0]->ids, count * sizeof(int));
+
+    for (int i = 1; i < word_count && count > 0; i++)
+    {
+        int kept = 0;
+
+        for (int j = 0; j < count; j++)
+        {
+            int pos = posting_position(entries[i], (*ids)[j]);
+
+            if (pos < entries[i]->count && entries[i]->ids[pos] == (*ids)[j])
+                (*ids)[kept++] = (*ids)[j];
+        }
+
+        count = kept;
+    }
+
+    free(entries);
+
+    return count;
+}
+
+// Function to check if the words of a phrase appear one after the other in a text
+static int has_phrase(char *text, char (*phrase)[WORD_LIMIT + 1], int length)
+{
+    char word[WORD_LIMIT + 1];
+
+    if (length == 0)
+        return 1;
+
+    while ((text = next_word(text, word)) != NULL)
+    {
+        if (strcmp(word, phrase[0]))
+            continue;
+
+        // Matching the rest of the phrase from here on
+        char *rest = text;
+        int matched = 1;
+
+        while (matched < length && (rest = next_word(rest, word)) != NULL && !strcmp(word, phrase[matched]))
+            matched++;
+
+        if (matched == length)
+            return 1;
+    }
+
+    return 0;
+}
+
+// Function to check if the content or one of the posts of a node has a phrase
+static int node_has_phrase(void *node, char (*phrase)[WORD_LIMIT + 1], int length)
+{
+    struct post_cursor cursor;
+    char *post;
+
+    if (has_phrase(NODE_CONTENT(node), phrase, length))
+        return 1;
+
+    post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+    while ((post = post_log_next(&cursor)) != NULL)
+        if (has_phrase(post, phrase, length))
+            return 1;
+
+    return 0;
+}
+
+// Function to check if the content or one of the posts of a node has a string in it. A string without new lines can't
+// span two posts, as they are shown two new lines apart
+static int node_contains(void *node, char *string)
+{
+    struct post_cursor cursor;
+    char *post;
+
+    if (strstr(NODE_CONTENT(node), string) != NULL)
+        return 1;
+
+    post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+    while ((post = post_log_next(&cursor)) != NULL)
+        if (strstr(post, string) != NULL)
+            return 1;
+
+    return 0;
+}
+
+// Function to check if a node matches a word query, i.e has every quoted phrase in it's content or a post
+static int matches_phrases(void *node, char *query, char (*words)[WORD_LIMIT + 1])
+{
+    char *quote = strchr(query, '"');
+
+    while (quote != NULL)
+    {
+        char *end = strchr(quote + 1, '"');
+        int length = 0;
+
+        // Splitting the phrase into words, the closing quote is optional
+        char *text = quote + 1;
+
+        while ((end == NULL || text < end) && (text = next_word(text, words[length])) != NULL && (end == NULL || text <= end))
+            length++;
+
+        if (!node_has_phrase(node, words, length))
+            return 0;
+
+        quote = (end == NULL) ? NULL : strchr(end + 1, '"');
+    }
+
+    return 1;
+}
+
+// Function to find a pattern in a text one byte at a time, used on any machine and for the ends of the SIMD kernels
+static const char *find_scalar(const char *text, size_t size, const char *pattern, size_t length)
+{
+    if (length == 0)
+        return text;
+
+    if (size < length)
+        return NULL;
+
+    const char *last = text + size - length; // Last position a match can start at
+
+    for (const char *curr = text; curr <= last; curr++)
+    {
+        curr = (const char *)memchr(curr, pattern[0], last - curr + 1);
+
+        if (curr == NULL)
+            return NULL;
+
+        if (!memcmp(curr + 1, pattern + 1, length - 1))
+            return curr;
+    }
+
+    return NULL;
+}
+
+#ifdef SUBSTRING_SIMD
+
+// Function to find a pattern in a text 16 positions at a time. The positions where both the first and the last byte
+// of the pattern match are found with two compares, and only those are checked with memcmp
+__attribute__((target("sse2")))
+static const char *find_sse2(const char *text, size_t size, const char *pattern, size_t length)
+{
+    if (length < 2 || size < length)
+        return find_scalar(text, size, pattern, length);
+
+    __m128i first = _mm_set1_epi8(pattern[0]);
+    __m128i last = _mm_set1_epi8(pattern[length - 1]);
+    size_t i = 0;
+
+    for (; i + length - 1 + 16 <= size; i += 16)
+    {
+        __m128i block_first = _mm_loadu_si128((const __m128i *)(text + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i *)(text + i + length - 1));
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+
+        while (mask != 0)
+        {
+            int bit = __builtin_ctz(mask);
+
+            if (!memcmp(text + i + bit + 1, pattern + 1, length - 2))
+                return text + i + bit;
+
+            mask &= mask - 1;
+        }
+    }
+
+    // The last few positions that don't fill a block
+    return find_scalar(text + i, size - i, pattern, length);
+}
+
+// Function to find a pattern in a text 32 positions at a time, the same way as find_sse2()
+__attribute__((target("avx2")))
+static const char *find_avx2(const char *text, size_t size, const char *pattern, size_t length)
+{
+    if (length < 2 || size < length)
+        return find_scalar(text, size, pattern, length);
+
+    __m256i first = _mm256_set1_epi8(pattern[0]);
+    __m256i last = _mm256_set1_epi8(pattern[length - 1]);
+    size_t i = 0;
+
+    for (; i + length - 1 + 32 <= size; i += 32)
+    {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(text + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i *)(text + i + length - 1));
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)));
+
+        while (mask != 0)
+        {
+            int bit = __builtin_ctz(mask);
+
+            if (!memcmp(text + i + bit + 1, pattern + 1, length - 2))
+                return text + i + bit;
+
+            mask &= mask - 1;
+        }
+    }
+
+    return find_sse2(text + i, size - i, pattern, length);
+}
+
+// Functions telling if the machine running the program can use a kernel
+static int has_sse2()
+{
+    return __builtin_cpu_supports("sse2");
+}
+
+static int has_avx2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+static int always()
+{
+    return 1;
+}
+
+// The kernels from the slowest to the fastest
+const struct substring_kernel substring_kernels[] = {
+    {"scalar", always, find_scalar},
+#ifdef SUBSTRING_SIMD
+    {"sse2", has_sse2, find_sse2},
+    {"avx2", has_avx2, find_avx2},
+#endif
+};
+
+const int substring_kernel_count = sizeof(substring_kernels) / sizeof(substring_kernels[0]);
+
+// Function to get the fastest kernel the machine can run, chosen the first time it is asked for
+const struct substring_kernel *substring_kernel_select()
+{
+    static const struct substring_kernel *selected = NULL;
+
+    if (selected == NULL)
+    {
+        for (int i = 0; i < substring_kernel_count; i++)
+            if (substring_kernels[i].supported())
+                selected = &substring_kernels[i];
+    }
+
+    return selected;
+}
+
+// Function to mark the content arena as out of date
+void content_arena_mark_stale()
+{
+    all_Contents.stale = 1;
+}
+
+// Function to get an up to date content arena, with the contents in the order of the dense indices of the graph
+struct content_arena *content_arena_build(struct csr_graph *graph)
+{
+    struct content_arena *arena = &all_Contents;
+
+    if (!arena->stale)
+        return arena;
+
+    if (arena->node_capacity < graph->node_count + 1)
+    {
+        size_t *temp = (size_t *)realloc(arena->starts, (graph->node_count + 1) * sizeof(size_t));
+
+        if (temp == NULL)
+        {
+            printf("Memory allocation failed. Please try again\n");
+            return NULL;
+        }
+
+        arena->starts = temp;
+        arena->node_capacity = graph->node_count + 1;
+    }
+
+    // Finding where every content starts. Each one is followed by it's posts, as they are printed, and a '\0'
+    size_t size = 0;
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        struct post_log *log = NODE_POSTS(graph->nodes[i]);
+
+        arena->starts[i] = size;
+        size += strlen(NODE_CONTENT(graph->nodes[i])) + 1;
+
+        if (log != NULL)
+            size += log->bytes + log->count; // Two new lines before every post, one of them in place of it's '\0'
+    }
+
+    arena->starts[graph->node_count] = size;
+
+    if (arena->capacity < size + 1)
+    {
+        char *temp = (char *)realloc(arena->text, size + 1);
+
+        if (temp == NULL)
+        {
+            printf("Memory allocation failed. Please try again\n");
+            return NULL;
+        }
+
+        arena->text = temp;
+        arena->capacity = size + 1;
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        struct post_cursor cursor;
+        char *post;
+        char *curr = arena->text + arena->starts[i];
+        size_t length = strlen(NODE_CONTENT(graph->nodes[i]));
+
+        memcpy(curr, NODE_CONTENT(graph->nodes[i]), length);
+        curr += length;
+
+        post_log_seek(NODE_POSTS(graph->nodes[i]), 0, &cursor);
+
+        while ((post = post_log_next(&cursor)) != NULL)
+        {
+            length = strlen(post);
+
+            memcpy(curr, "\n\n", 2);
+            memcpy(curr + 2, post, length);
+            curr += length + 2;
+        }
+
+        *curr = '\0';
+    }
+
+    arena->size = size;
+    arena->node_count = graph->node_count;
+    arena->stale = 0;
+
+    return arena;
+}
+
+// Function to find the nodes with a pattern in their content by scanning the content arena with a kernel, the nodes
+// are written to found in the order of the global lists
+static int content_scan(struct csr_graph *graph, const struct substring_kernel *kernel, char *pattern, void **found)
+{
+    struct content_arena *arena = content_arena_build(graph);
+
+    if (arena == NULL)
+        return -1;
+
+    size_t length = strlen(pattern);
+    size_t pos = 0;
+    int node = 0, count = 0;
+
+    while (pos < arena->size)
+    {
+        const char *match = kernel->find(arena->text + pos, arena->size - pos, pattern, length);
+
+        if (match == NULL)
+            break;
+
+        // A pattern can't have a '\0', so the match is inside a single content
+        size_t offset = match - arena->text;
+
+        while (arena->starts[node + 1] <= offset)
+            node++;
+
+        if (found != NULL)
+            found[count] = graph->nodes[node];
+
+        count++;
+
+        // The rest of this content doesn't matter any more
+        pos = arena->starts[++node];
+    }
+
+    return count;
+}
+
+// Function to free everything a pattern set holds, leaving it empty
+void pattern_set_clear(struct pattern_set *set)
+{
+    for (int i = 0; i < set->pattern_count; i++)
+        free(set->patterns[i]);
+
+    free(set->patterns);
+    free(set->numbers);
+    free(set->transitions);
+    free(set->fail);
+    free(set->ends);
+    free(set->match);
+    free(set->seen);
+
+    memset(set, 0, sizeof(struct pattern_set));
+}
+
+// Function to add a state to the trie being built, returns it's number or -1 if memory allocation failed
+static int pattern_set_add_state(struct pattern_set *set)
+{
+    if (set->state_count == set->state_capacity)
+    {
+        int new_capacity = set->state_capacity ? set->state_capacity * 2 : 64;
+        int *transitions = (int *)realloc(set->transitions, (size_t)new_capacity * set->class_count * sizeof(int));
+
+        if (transitions == NULL)
+            return -1;
+
+        set->transitions = transitions;
+
+        int *ends = (int *)realloc(set->ends, new_capacity * sizeof(int));
+
+        if (ends == NULL)
+            return -1;
+
+        set->ends = ends;
+        set->state_capacity = new_capacity;
+    }
+
+    int state = set->state_count++;
+
+    // 0 is the root, which no trie edge leads back to, so it also stands for a missing edge while building
+    memset(set->transitions + (size_t)state * set->class_count, 0, set->class_count * sizeof(int));
+    set->ends[state] = -1;
+
+    return state;
+}
+
+// Function to compile patterns into a pattern set (an Aho-Corasick automaton), replacing what it held before
+int pattern_set_compile(struct pattern_set *set, char **patterns, int *numbers, int count)
+{
+    pattern_set_clear(set);
+
+    // Only the bytes used by the patterns need a column of their own, every other byte sends the automaton back to
+    // the root. Letters share a column with their other case, so the matching ignores case and there are never more
+    // than 256 - 26 columns
+    set->class_count = 1;
+
+    for (int i = 0; i < count; i++)
+    {
+        for (unsigned char *curr = (unsigned char *)patterns[i]; *curr != '\0'; curr++)
+        {
+            unsigned char lower = (unsigned char)tolower(*curr);
+
+            if (set->classes[lower] == 0)
+            {
+                set->classes[lower] = (unsigned char)set->class_count;
+                set->classes[toupper(lower)] = (unsigned char)set->class_count;
+                set->class_count++;
+            }
+        }
+    }
+
+    set->patterns = (char **)malloc((count + 1) * sizeof(char *));
+    set->numbers = (int *)malloc((count + 1) * sizeof(int));
+
+    if (set->patterns == NULL || set->numbers == NULL || pattern_set_add_state(set) < 0)
+    {
+        pattern_set_clear(set);
+        return 0;
+    }
+
+    // Building the trie of the patterns
+    for (int i = 0; i < count; i++)
+    {
+        if (patterns[i][0] == '\0')
+            continue; // An empty pattern would match everything
+
+        int state = 0;
+
+        for (unsigned char *curr = (unsigned char *)patterns[i]; *curr != '\0'; curr++)
+        {
+            int *edge = &set->transitions[(size_t)state * set->class_count + set->classes[*curr]];
+
+            if (*edge == 0)
+            {
+                int next = pattern_set_add_state(set);
+
+                if (next < 0)
+                {
+                    pattern_set_clear(set);
+                    return 0;
+                }
+
+                edge = &set->transitions[(size_t)state * set->class_count + set->classes[*curr]]; // Moved if it grew
+                *edge = next;
+            }
+
+            state = *edge;
+        }
+
+        if (set->ends[state] >= 0)
+            continue; // The same pattern twice, the first one is reported
+
+        set->patterns[set->pattern_count] = (char *)malloc(strlen(patterns[i]) + 1);
+
+        if (set->patterns[set->pattern_count] == NULL)
+        {
+            pattern_set_clear(set);
+            return 0;
+        }
+
+        strcpy(set->patterns[set->pattern_count], patterns[i]);
+        set->numbers[set->pattern_count] = (numbers == NULL) ? i + 1 : numbers[i];
+        set->ends[state] = set->pattern_count++;
+    }
+
+    set->fail = (int *)calloc(set->state_count, sizeof(int));
+    set->match = (int *)calloc(set->state_count, sizeof(int));
+    set->seen = (unsigned int *)calloc(set->pattern_count + 1, sizeof(unsigned int));
+
+    int *queue = (int *)malloc(set->state_count * sizeof(int));
+
+    if (set->fail == NULL || set->match == NULL || set->seen == NULL || queue == NULL)
+    {
+        free(queue);
+        pattern_set_clear(set);
+        return 0;
+    }
+
+    // Going through the trie breadth first, so that the failure state of every state is finished before it. Every
+    // missing edge is then replaced by the edge of the failure state, turning the trie into a DFA
+    int head = 0, tail = 0;
+
+    queue[tail++] = 0;
+
+    while (head < tail)
+    {
+        int state = queue[head++];
+        int *row = set->transitions + (size_t)state * set->class_count;
+        int *fail_row = set->transitions + (size_t)set->fail[state] * set->class_count;
+
+        // The nearest state, this one or a suffix of it, at which a pattern ends
+        set->match[state] = (set->ends[state] >= 0) ? state : set->match[set->fail[state]];
+
+        for (int c = 1; c < set->class_count; c++)
+        {
+            if (row[c] == 0)
+            {
+                row[c] = (state == 0) ? 0 : fail_row[c];
+                continue;
+            }
+
+            set->fail[row[c]] = (state == 0) ? 0 : fail_row[c];
+            queue[tail++] = row[c];
+        }
+    }
+
+    free(queue);
+
+    return 1;
+}
+
+// Function to run a pattern set over texts stored one after the other, texts[starts[i]] to texts[starts[i + 1] - 1]
+// being the content of nodes[i], or of the node with the given id if nodes is NULL. Every (node, pattern) pair found
+// is added once to out, returns the number of pairs added or -1 if memory allocation failed
+static int pattern_set_scan(struct pattern_set *set, const char *text, const size_t *starts, int text_count, void **nodes, int id, struct match_list *out)
+{
+    int added = 0;
+
+    if (set->pattern_count == 0)
+        return 0;
+
+    for (int i = 0; i < text_count; i++)
+    {
+        int state = 0;
+        unsigned int epoch = ++set->epoch;
+
+        for (const unsigned char *curr = (const unsigned char *)text + starts[i]; curr < (const unsigned char *)text + starts[i + 1]; curr++)
+        {
+            state = set->transitions[(size_t)state * set->class_count + set->classes[*curr]];
+
+            // Every pattern ending here, following the suffixes that are patterns themselves
+            for (int found = set->match[state]; found != 0; found = set->match[set->fail[found]])
+            {
+                int pattern = set->ends[found];
+
+                if (set->seen[pattern] == epoch)
+                    continue; // Already reported for this node
+
+                set->seen[pattern] = epoch;
+
+                if (out->count == out->capacity)
+                {
+                    int new_capacity = out->capacity ? out->capacity * 2 : 64;
+                    struct pattern_match *temp = (struct pattern_match *)realloc(out->matches, new_capacity * sizeof(struct pattern_match));
+
+                    if (temp == NULL)
+                        return -1;
+
+                    out->matches = temp;
+                    out->capacity = new_capacity;
+                }
+
+                out->matches[out->count].id = (nodes != NULL) ? NODE_ID(nodes[i]) : id;
+                out->matches[out->count].pattern = pattern;
+                out->matches[out->count].number = set->numbers[pattern];
+                out->count++;
+                added++;
+            }
+        }
+    }
+
+    return added;
+}
+
+// Function to load the blocked phrases from a file, one per line
+int blocklist_load(FILE *input)
+{
+    char **phrases = NULL;
+    int *line_numbers = NULL;
+    int count = 0, capacity = 0;
+    int line_number = 0, line_start = 1;
+    char line[4096];
+
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        // A line longer than the buffer is read in parts, all of them from the same line
+        line_number += line_start;
+        line_start = (strchr(line, '\n') != NULL);
+
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (line[0] == '\0')
+            continue;
+
+        if (count == capacity)
+        {
+            int new_capacity = capacity ? capacity * 2 : 64;
+            char **temp = (char **)realloc(phrases, new_capacity * sizeof(char *));
+
+            if (temp == NULL)
+                break;
+
+            phrases = temp;
+
+            int *numbers = (int *)realloc(line_numbers, new_capacity * sizeof(int));
+
+            if (numbers == NULL)
+                break;
+
+            line_numbers = numbers;
+            capacity = new_capacity;
+        }
+
+        if ((phrases[count] = (char *)malloc(strlen(line) + 1)) == NULL)
+            break;
+
+        strcpy(phrases[count], line);
+        line_numbers[count++] = line_number;
+    }
+
+    int compiled = !ferror(input) && pattern_set_compile(&blocklist, phrases, line_numbers, count);
+
+    for (int i = 0; i < count; i++)
+        free(phrases[i]);
+
+    free(phrases);
+    free(line_numbers);
+
+    return compiled ? blocklist.pattern_count : -1;
+}
+
+// Function to find every blocked phrase in every content in a single pass, the pairs found are left in found_matches
+int blocklist_search()
+{
+    struct csr_graph *graph = csr_snapshot();
+    struct content_arena *arena = (graph == NULL) ? NULL : content_arena_build(graph);
+
+    if (arena == NULL)
+        return -1;
+
+    found_matches.count = 0;
+
+    return pattern_set_scan(&blocklist, arena->text, arena->starts, arena->node_count, graph->nodes, 0, &found_matches);
+}
+
+// Function to check a new post of a node against the blocklist, the matches are added to flagged_posts
+int blocklist_check(int id, char *post)
+{
+    size_t starts[2] = {0, strlen(post)};
+
+    return pattern_set_scan(&blocklist, post, starts, 1, NULL, id, &flagged_posts);
+}
+
+// Function to load a blocklist and print every blocked phrase in every content
+void check_blocklist(char path[])
+{
+    FILE *input = fopen(path, "r");
+
+    if (input == NULL)
+    {
+        printf("Could not open %s\n", path);
+        return;
+    }
+
+    int count = blocklist_load(input);
+
+    fclose(input);
+
+    if (count < 0 || blocklist_search() < 0)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return;
+    }
+
+    printf("Loaded %d blocked phrase(s), new posts will be checked against them\n", count);
+
+    if (found_matches.count == 0)
+    {
+        printf("No content has a blocked phrase\n\n");
+        return;
+    }
+
+    for (int i = 0; i < found_matches.count; i++)
+    {
+        void *node = id_index_find(found_matches.matches[i].id)->node;
+
+        printf("%s %s (ID %d) has \"%s\"\n", kind_info[NODE_KIND(node)].type, NODE_NAME(node), NODE_ID(node),
+               blocklist.patterns[found_matches.matches[i].pattern]);
+    }
+}
+
+// Function to find the nodes whose content matches a query, in the order of the global lists
+int content_search(char query[], int whole_words)
+{
+    struct csr_graph *graph = csr_snapshot(); // The dense indices give the order of the global lists
+
+    if (graph == NULL)
+        return -1;
+
+    size_t length = strlen(query);
+
+    // Every word takes atleast one character along with a separator, and there are length - 2 trigrams
+    char (*words)[WORD_LIMIT + 1] = malloc((length / 2 + length + 1) * sizeof(*words));
+
+    if (words == NULL)
+        return -1;
+
+    struct word_index *index = &all_Words;
+    int word_count = 0;
+
+    if ((pending_indexes & INDEX_WORDS) && !index_require(INDEX_WORDS))
+    {
+        free(words);
+        return -1;
+    }
+
+    if (whole_words)
+    {
+        char *text = query;
+
+        while ((text = next_word(text, words[word_count])) != NULL)
+            word_count++;
+    }
+    else
+    {
+        // A node can only have the substring if it has every trigram of it
+        index = &all_Trigrams;
+
+        for (size_t i = 0; i + 3 <= length; i++)
+        {
+            memcpy(words[word_count], query + i, 3);
+            words[word_count++][3] = '\0';
+        }
+    }
+
+    if (!found_reserve(graph->node_count + 1))
+    {
+        free(words);
+        return -1;
+    }
+
+    int candidate_count = 0;
+
+    if (word_count == 0 && !whole_words)
+    {
+        // Too short to have a trigram, so every content is scanned
+        free(words);
+
+        return content_scan(graph, substring_kernel_select(), query, found_nodes);
+    }
+
+    if (word_count > 0)
+    {
+        int *ids;
+
+        candidate_count = intersect_words(index, words, word_count, &ids);
+
+        if (candidate_count < 0)
+        {
+            free(words);
+            return -1;
+        }
+
+        for (int i = 0; i < candidate_count; i++)
+            found_nodes[i] = id_index_find(ids[i])->node;
+
+        free(ids);
+
+        qsort(found_nodes, candidate_count, sizeof(void *), compare_csr_index);
+    }
+
+    // Checking the candidates themselves
+    int count = 0;
+
+    for (int i = 0; i < candidate_count; i++)
+        if (whole_words ? matches_phrases(found_nodes[i], query, words) : node_contains(found_nodes[i], query))
+            found_nodes[count++] = found_nodes[i];
+
+    free(words);
+
+    return count;
+}
+
+// Function to print the nodes found by a content search
+static void print_found(int count)
+{
+    if (count <= 0)
+    {
+        printf("There are no matches\n\n");
+        return;
+    }
+
+    printf("The node(s) with the given string present in their content are:- \n");
+
+    for (int i = 0; i < count; i++)
+        print_node(found_nodes[i]);
+}
+
+// Function to search for and print content
+void search_for_content(char string[])
+{
+    print_found(content_search(string, 0));
+}
+
+// Function to search for and print the nodes using some words or "quoted phrases"
+void search_for_words(char query[])
+{
+    print_found(content_search(query, 1));
+}
+
+// Function to find the bucket of the birthday index a date goes into
+static int birthday_bucket(int day, int month)
+{
+    if (month < 1 || month > 12 || day < 1 || day > 31)
+        return 0; // Not a real day, all of them share the first bucket
+
+    return month * 32 + day;
+}
+
+// Function to compare two entries of the birthday index by their birthday, and then by id
+static int compare_birthdays(const struct birthday_entry *a, const struct birthday_entry *b)
+{
+    if (a->year != b->year)
+        return (a->year > b->year) - (a->year < b->year);
+    if (a->month != b->month)
+        return (a->month > b->month) - (a->month < b->month);
+    if (a->day != b->day)
+        return (a->day > b->day) - (a->day < b->day);
+
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+// Function to find the position of the first entry of a bucket that isn't smaller than the given one
+static int birthday_position(struct birthday_bucket *bucket, struct birthday_entry *entry)
+{
+    int low = 0, high = bucket->count;
+
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+
+        if (compare_birthdays(&bucket->entries[mid], entry) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+// Function to add an individual to the birthday index
+int birthday_index_insert(int id, struct tm *birthday)
+{
+    if ((pending_indexes & INDEX_BIRTHDAYS) || birthday == NULL || birthday->tm_mday == -1)
+        return 1; // No birthday to index, or it is added along with the rest once the index is built
+
+    struct birthday_entry entry = {birthday->tm_year, birthday->tm_mon, birthday->tm_mday, id};
+    struct birthday_bucket *bucket = &all_Birthdays[birthday_bucket(entry.day, entry.month)];
+
+    if (bucket->count == bucket->capacity)
+    {
+        int new_capacity = bucket->capacity ? bucket->capacity * 2 : 8;
+        struct birthday_entry *temp = (struct birthday_entry *)realloc(bucket->entries, new_capacity * sizeof(struct birthday_entry));
+
+        if (temp == NULL)
+            return 0;
+
+        bucket->entries = temp;
+        bucket->capacity = new_capacity;
+    }
+
+    // Keeping the bucket sorted, which only moves the entries born on the same day and month
+    int pos = birthday_position(bucket, &entry);
+
+    memmove(&bucket->entries[pos + 1], &bucket->entries[pos], (bucket->count - pos) * sizeof(struct birthday_entry));
+    bucket->entries[pos] = entry;
+    bucket->count++;
+    birthday_count++;
+
+    return 1;
+}
+
+// Function to remove an individual from the birthday index
+void birthday_index_remove(int id, struct tm *birthday)
+{
+    if (birthday == NULL || birthday->tm_mday == -1)
+        return;
+
+    struct birthday_entry entry = {birthday->tm_year, birthday->tm_mon, birthday->tm_mday, id};
+    struct birthday_bucket *bucket = &all_Birthdays[birthday_bucket(entry.day, entry.month)];
+
+    int pos = birthday_position(bucket, &entry);
+
+    if (pos == bucket->count || bucket->entries[pos].id != id)
+        return; // Never indexed
+
+    memmove(&bucket->entries[pos], &bucket->entries[pos + 1], (bucket->count - pos - 1) * sizeof(struct birthday_entry));
+    bucket->count--;
+    birthday_count--;
+}
+
+// Function to find the individuals born on a date
+int birthdays_on(int day, int month, int year)
+{
+    struct birthday_bucket *bucket = &all_Birthdays[birthday_bucket(day, month)];
+
+    if ((pending_indexes & INDEX_BIRTHDAYS) && !index_require(INDEX_BIRTHDAYS))
+        return -1;
+
+    if (!found_reserve(bucket->count + 1))
+        return -1;
+
+    // The entries born in the year are next to each other, starting from the first one not smaller than the date
+    struct birthday_entry first = {year, month, day, 0};
+    int count = 0;
+
+    for (int pos = birthday_position(bucket, &first); pos < bucket->count && bucket->entries[pos].year == year; pos++)
+    {
+        struct birthday_entry *entry = &bucket->entries[pos];
+
+        if (entry->day == day && entry->month == month)      // Only needed for the bucket of the dates that aren't real
+            found_nodes[count++] = id_index_find(entry->id)->node;
+    }
+
+    // The same order search_by_birthday() always printed them in, that of the global list
+    if (count > 1 && csr_snapshot() != NULL)
+        qsort(found_nodes, count, sizeof(void *), compare_csr_index);
+
+    return count;
+}
+
+// Function to find the individuals born on a day and month, of any year
+int birthdays_on_day(int day, int month)
+{
+    struct birthday_bucket *bucket = &all_Birthdays[birthday_bucket(day, month)];
+
+    if ((pending_indexes & INDEX_BIRTHDAYS) && !index_require(INDEX_BIRTHDAYS))
+        return -1;
+
+    if (!found_reserve(bucket->count + 1))
+        return -1;
+
+    int count = 0;
+
+    for (int pos = 0; pos < bucket->count; pos++)
+    {
+        struct birthday_entry *entry = &bucket->entries[pos];
+
+        if (entry->day == day && entry->month == month)
+            found_nodes[count++] = id_index_find(entry->id)->node;
+    }
+
+    return count;
+}
+
+// Function to tell if a year is a leap year
+static int leap_year(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Function to find the number of days in a month
+static int month_days(int month, int year)
+{
+    static const int days[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    return (month == 2 && leap_year(year)) ? 29 : days[month];
+}
+
+// Function to find the individuals having their birthday in the days starting from a date
+int upcoming_birthdays(struct tm *from, int days)
+{
+    int day = from->tm_mday, month = from->tm_mon, year = from->tm_year;
+
+    if (month < 1 || month > 12 || day < 1 || day > month_days(month, year) || days < 0)
+        return -1;
+
+    if ((pending_indexes & INDEX_BIRTHDAYS) && !index_require(INDEX_BIRTHDAYS))
+        return -1;
+
+    if (!found_reserve(birthday_count + 1))
+        return -1;
+
+    // A bucket is taken only once, so that a whole year (or more) doesn't list anyone twice
+    char taken[BIRTHDAY_BUCKETS] = {0};
+    int count = 0;
+
+    for (int i = 0; i < days && i < 366; i++)
+    {
+        int buckets[2] = {birthday_bucket(day, month), 0};
+
+        if (month == 2 && day == 28 && !leap_year(year))
+            buckets[1] = birthday_bucket(29, 2);                // The 29th of February is had on the 28th this year
+
+        for (int j = 0; j < 2 && buckets[j] != 0; j++)
+        {
+            struct birthday_bucket *bucket = &all_Birthdays[buckets[j]];
+
+            if (taken[buckets[j]])
+                continue;
+
+            taken[buckets[j]] = 1;
+
+            for (int pos = 0; pos < bucket->count; pos++)
+                found_nodes[count++] = id_index_find(bucket->entries[pos].id)->node;
+        }
+
+        // Moving to the next day
+        if (++day > month_days(month, year))
+        {
+            day = 1;
+
+            if (++month > 12)
+            {
+                month = 1;
+                year++;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Function to print the individuals having their birthday in the days starting from a date
+void print_upcoming_birthdays(struct tm *from, int days)
+{
+    int count = upcoming_birthdays(from, days);
+
+    if (count < 0)
+    {
+        printf("Invalid date\n\n");
+        return;
+    }
+
+    if (count == 0)
+    {
+        printf("There are no birthdays in the given days\n\n");
+        return;
+    }
+
+    printf("The node(s) having their birthday are:- \n\n");
+
+    for (int i = 0; i < count; i++)
+        print_node(found_nodes[i]);
+}
+
+// Function to compare two nodes by their score, the highest first, and then by id
+static int compare_scores(const void *a, const void *b)
+{
+    void *x = *(void **)a;
+    void *y = *(void **)b;
+
+    if (NODE_SCORE(x) != NODE_SCORE(y))
+        return (NODE_SCORE(x) < NODE_SCORE(y)) - (NODE_SCORE(x) > NODE_SCORE(y));
+
+    return (NODE_ID(x) > NODE_ID(y)) - (NODE_ID(x) < NODE_ID(y));
+}
+
+// Function to find the nodes with the highest scores
+int top_scores(int kind, int count)
+{
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL || !found_reserve(graph->node_count + 1))
+        return -1;
+
+    int found = 0;
+
+    for (int i = 0; i < graph->node_count; i++)
+        if (kind == -1 || graph->kinds[i] == kind)
+            found_nodes[found++] = graph->nodes[i];
+
+    if (found > 1)
+        qsort(found_nodes, found, sizeof(void *), compare_scores);
+
+    return (found < count) ? found : count;
+}
+
+// Function to print the nodes with the highest scores
+void print_top_scores(int kind, int count)
+{
+    pagerank_poll(0);
+
+    if (!pagerank_ready && pagerank_compute(0.85, 1e-6, 100) < 0)
+    {
+        printf("Memory allocation failed. Please try again\n");
+        return;
+    }
+
+    count = top_scores(kind, count);
+
+    if (count <= 0)
+    {
+        printf("There are no such nodes\n\n");
+        return;
+    }
+
+    printf("The most influential node(s) are:- \n\n");
+
+    for (int i = 0; i < count; i++)
+        print_node(found_nodes[i]);
+}
+
+// Function to print all nodes
+void print_all()
+{
+    int flag = 1;
+
+    // Temporary iterators to search
+
+    struct individual *temp_ind = all_Individuals;
+    struct business *temp_bus = all_business;
+    struct organisation *temp_org = all_Organisation;
+    struct group *temp_grp = all_Group;
+
+    while (temp_ind != NULL)                                // Iterating over all the individuals
+    {
+        print_node(temp_ind);
+
+        if (flag)
+        {
+            printf("\n All the nodes present are:-\n\n");
+            flag = 0;
+        }
+        temp_ind = temp_ind->next;                           // Moving on to the next individual
+    }
+    while (temp_bus != NULL)                                 // Iterating over all the businesses
+    {
+        print_node(temp_bus);
+
+        if (flag)
+        {
+            printf("\n All the nodes present are:-\n\n");
+            flag = 0;
+        }
+        temp_bus = temp_bus->next;                           // Moving on to the next business
+    }
+    while (temp_org != NULL)                                // Iterating over all the organisations                            
+    {
+        print_node(temp_org);
+
+        if (flag)
+        {
+            printf("\n All the nodes present are:-\n\n");
+            flag = 0;
+        }
+        temp_org = temp_org->next;                           // Moving on to the next organisation
+    }
+    while (temp_grp != NULL)                                // Iterating over all the groups
+    {
+        print_node(temp_grp);
+
+        if (flag)
+        {
+            printf("\n All the nodes present are:-\n\n");
+            flag = 0;
+        }
+        temp_grp = temp_grp->next;                           // Moving on to the next group
+    }
+
+    if (flag)
+    {
+        printf("No nodes exist\n");                          // If no nodes exists currently in the system
+    }
+}
+
+// Function to remove a node with a given id
+int remove_node(int id)
+{
+    struct id_slot *slot = id_index_find(id);                           // Finding the node through the ID index
+
+    if (slot == NULL)
+        return 0; // No such node exists
+
+    void *node = slot->node;
+    enum node_kind kind = slot->kind;
+
+    wal_record("delete|%d", id);
+
+    id_index_remove(id);                                                // The node is going away, so is it's entry in the index
+
+    // Removing every link of the node, both the node's own cell and it's twin in the list of the other node.
+    // The twin unlinks itself, so only the node's own lists are walked and the time taken depends on it's degree alone
+    struct linked_cell **heads[3];
+    int list_count = node_list_heads(node, heads);
+
+    for (int list = 0; list < list_count; list++)
+    {
+        while (*heads[list] != NULL)
+        {
+            struct linked_cell *cell = *heads[list];
+            struct linked_cell *twin = cell->twin;
+
+            cell_unlink(twin);
+            pool_free(linked_pools[kind], twin);                        // The twin points back to this node
+
+            cell_unlink(cell);
+            pool_free(linked_pools[NODE_KIND(cell->node)], cell);
+        }
+    }
+
+    node_list_unlink(node);                                             // Removing the node from it's global list
+
+    if (kind == NODE_INDIVIDUAL)
+    {
+        birthday_index_remove(id, ((struct individual *)node)->birthday);
+        release_memory(((struct individual *)node)->birthday);          // Unique attribute
+    }
+
+    // Freeing the attributes of the node
+    name_index_remove(kind, NODE_NAME(node), node);                     // Removing the node from the name index before it's name is freed
+    word_index_remove(id, NODE_CONTENT(node));                          // and from the word index before it's content is
+    trigram_index_remove(id, NODE_CONTENT(node));
+    spatial_index_remove(node);
+
+    struct post_cursor cursor;
+    char *post;
+
+    post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+    while ((post = post_log_next(&cursor)) != NULL)                     // along with every post
+    {
+        word_index_remove(id, post);
+        trigram_index_remove(id, post);
+    }
+    release_memory(NODE_NAME(node));
+    release_memory(*NODE_FIELD(node, struct tm *, creation));
+    release_memory(NODE_CONTENT(node));
+    post_log_free(NODE_POSTS(node));
+
+    // Finally deleting the node
+    pool_free(node_pools[kind], node);
+
+    csr_mark_stale();
+    components_mark_dirty();                                            // The component of the node may have split
+    content_arena_mark_stale();
+
+    return 1;
+}
+
+// Function to delete a node
+void delete_node()
+{
+    printf("Enter the ID of the node you want to delete:- ");
+    int id;
+    scanf("%d%c", &id, &throwaway);
+
+    if (remove_node(id))
+        printf("\n******** Successfully deleted ********\n");
+    else
+        printf("No such node exists\n");
+}
+
+// Function to move a node to a new address, fixing every pointer to it
+static void move_node(void *from, void *to)
+{
+    enum node_kind kind = NODE_KIND(from);
+
+    memcpy(to, from, node_pools[kind]->object_size);
+
+    id_index_find(NODE_ID(to))->node = to;
+    name_index_move(kind, NODE_NAME(to), from, to);
+
+    // The global list
+    *NODE_PPREV(to) = to;
+
+    if (NODE_NEXT(to) != NULL)
+        NODE_PPREV(NODE_NEXT(to)) = &NODE_NEXT(to);
+
+    // The first cell of each list points back at the head inside the node, and the twins point at the node itself
+    struct linked_cell **heads[3];
+    int list_count = node_list_heads(to, heads);
+
+    for (int list = 0; list < list_count; list++)
+    {
+        if (*heads[list] != NULL)
+            (*heads[list])->pprev = heads[list];
+
+        for (struct linked_cell *temp = *heads[list]; temp != NULL; temp = temp->next)
+            temp->twin->node = to;
+    }
+}
+
+// Function to move a linked cell to a new address, fixing every pointer to it
+static void move_cell(void *from, void *to)
+{
+    struct linked_cell *cell = (struct linked_cell *)to;
+
+    memcpy(to, from, sizeof(struct linked_cell));
+
+    *cell->pprev = cell;
+
+    if (cell->next != NULL)
+        cell->next->pprev = &cell->next;
+
+    cell->twin->twin = cell;
+}
+
+// Function to pack the nodes and cells into as few slabs as possible
+size_t compact_memory()
+{
+    size_t released = 0;
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+        released += pool_compact(node_pools[kind], move_node);
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+        released += pool_compact(linked_pools[kind], move_cell);
+
+    // The snapshot holds the old addresses of the nodes
+    if (released > 0)
+        csr_mark_stale();
+
+    return released;
+}
+
+// Function to delete many nodes at once
+int remove_nodes(int *ids, int count)
+{
+    int removed = 0;
+
+    // Every node unlinks only it's own cells and their twins, so no member list is searched
+    for (int i = 0; i < count; i++)
+        removed += remove_node(ids[i]);
+
+    // The holes left behind are filled in one pass, instead of after every node
+    if (removed > 0)
+        compact_memory();
+
+    return removed;
+}
+
+// Snapshots
+
+// Function to write a date of a node to the snapshot, only the day, month and year are kept
+static void snapshot_write_date(FILE *output, struct tm *date)
+{
+    struct tm copy;
+
+    memset(&copy, 0, sizeof(struct tm));
+    copy.tm_mday = date->tm_mday;
+    copy.tm_mon = date->tm_mon;
+    copy.tm_year = date->tm_year;
+
+    fwrite(&copy, sizeof(struct tm), 1, output);
+}
+
+// Function to save all the nodes and links to a snapshot file
+int save_snapshot(char *path)
+{
+    struct csr_graph *graph = csr_snapshot(); // Gives every node a dense index, and the links in the order they are saved
+
+    if (graph == NULL)
+        return 0;
+
+    // Written to a temporary file first, so that a crash never leaves a half written snapshot behind
+    char *temp_path = (char *)malloc(strlen(path) + 5);
+
+    if (temp_path == NULL)
+        return 0;
+
+    sprintf(temp_path, "%s.tmp", path);
+
+    FILE *output = fopen(temp_path, "wb");
+
+    if (output == NULL)
+    {
+        free(temp_path);
+        return 0;
+    }
+
+    setvbuf(output, NULL, _IOFBF, 1 << 16);
+
+    // Working out the size of every section, so that the header can be written first
+    struct snapshot_header header;
+    memset(&header, 0, sizeof(struct snapshot_header));
+
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.tm_size = sizeof(struct tm);
+    header.generation = wal.generation + 1;
+    header.node_count = graph->node_count;
+    header.link_count = graph->edge_count;
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        void *node = graph->nodes[i];
+
+        header.date_count += (graph->kinds[i] == NODE_INDIVIDUAL && ((struct individual *)node)->birthday != NULL) ? 2 : 1;
+        header.string_bytes += strlen(NODE_NAME(node)) + strlen(NODE_CONTENT(node)) + 2;
+
+        if (NODE_POSTS(node) != NULL)
+        {
+            header.string_bytes += NODE_POSTS(node)->bytes;
+            header.time_count += NODE_POSTS(node)->count;
+        }
+    }
+
+    header.nodes_offset = sizeof(struct snapshot_header);
+    header.dates_offset = header.nodes_offset + header.node_count * sizeof(struct snapshot_node);
+    header.times_offset = header.dates_offset + header.date_count * sizeof(struct tm);
+    header.links_offset = header.times_offset + header.time_count * sizeof(long long);
+    header.twins_offset = header.links_offset + header.link_count * sizeof(int);
+    header.strings_offset = header.twins_offset + header.link_count * sizeof(int);
+
+    fwrite(&header, sizeof(struct snapshot_header), 1, output);
+
+    // Node records, the dates and strings are numbered in the same order they are written below
+    long long date = 0;
+    long long string = 0;
+    long long post_time = 0;
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        void *node = graph->nodes[i];
+        struct snapshot_node record;
+        struct linked_cell **heads[3];
+
+        memset(&record, 0, sizeof(struct snapshot_node));
+
+        record.id = NODE_ID(node);
+        record.kind = graph->kinds[i];
+        record.creation = date++;
+        record.birthday = -1;
+
+        if (record.kind == NODE_INDIVIDUAL && ((struct individual *)node)->birthday != NULL)
+            record.birthday = date++;
+        else if (record.kind == NODE_BUSINESS)
+        {
+            record.x_cord = ((struct business *)node)->x_cord;
+            record.y_cord = ((struct business *)node)->y_cord;
+        }
+        else if (record.kind == NODE_ORGANISATION)
+        {
+            record.x_cord = ((struct organisation *)node)->x_cord;
+            record.y_cord = ((struct organisation *)node)->y_cord;
+        }
+        else if (record.kind == NODE_GROUP)
+        {
+            record.x_cord = ((struct group *)node)->x_cord;
+            record.y_cord = ((struct group *)node)->y_cord;
+        }
+
+        record.name = string;
+        string += strlen(NODE_NAME(node)) + 1;
+        record.content = string;
+        string += strlen(NODE_CONTENT(node)) + 1;
+        record.posts = string;
+        record.first_time = post_time;
+
+        if (NODE_POSTS(node) != NULL)
+        {
+            record.post_bytes = NODE_POSTS(node)->bytes;
+            record.post_count = NODE_POSTS(node)->count;
+            string += record.post_bytes;
+            post_time += record.post_count;
+        }
+
+        // The links are the neighbours of the node in the CSR snapshot, split up by list
+        record.first_link = graph->offsets[i];
+
+        int list_count = node_list_heads(node, heads);
+
+        for (int list = 0; list < list_count; list++)
+            for (struct linked_cell *temp = *heads[list]; temp != NULL; temp = temp->next)
+                record.list_sizes[list]++;
+
+        fwrite(&record, sizeof(struct snapshot_node), 1, output);
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        snapshot_write_date(output, *NODE_FIELD(graph->nodes[i], struct tm *, creation));
+
+        if (graph->kinds[i] == NODE_INDIVIDUAL && ((struct individual *)graph->nodes[i])->birthday != NULL)
+            snapshot_write_date(output, ((struct individual *)graph->nodes[i])->birthday);
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+        if (NODE_POSTS(graph->nodes[i]) != NULL)
+            for (struct post_chunk *chunk = NODE_POSTS(graph->nodes[i])->head; chunk != NULL; chunk = chunk->next)
+                fwrite(chunk->times, sizeof(long long), chunk->count, output);
+
+    if (graph->edge_count > 0)
+        fwrite(graph->neighbors, sizeof(int), graph->edge_count, output);
+
+    // The twin of every cell, as the position of the twin in the links section. The cells are numbered first, keeping
+    // the number in pprev for the moment since it is easy to put back once the twins are written
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        struct linked_cell **heads[3];
+        int list_count = node_list_heads(graph->nodes[i], heads);
+        size_t link = graph->offsets[i];
+
+        for (int list = 0; list < list_count; list++)
+            for (struct linked_cell *temp = *heads[list]; temp != NULL; temp = temp->next)
+                temp->pprev = (struct linked_cell **)link++;
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        struct linked_cell **heads[3];
+        int list_count = node_list_heads(graph->nodes[i], heads);
+
+        for (int list = 0; list < list_count; list++)
+        {
+            for (struct linked_cell *temp = *heads[list]; temp != NULL; temp = temp->next)
+            {
+                int twin = (int)(size_t)temp->twin->pprev;
+                fwrite(&twin, sizeof(int), 1, output);
+            }
+        }
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        struct linked_cell **heads[3];
+        int list_count = node_list_heads(graph->nodes[i], heads);
+
+        for (int list = 0; list < list_count; list++)
+        {
+            struct linked_cell **prev = heads[list];
+
+            for (struct linked_cell *temp = *heads[list]; temp != NULL; temp = temp->next)
+            {
+                temp->pprev = prev;
+                prev = &temp->next;
+            }
+        }
+    }
+
+    for (int i = 0; i < graph->node_count; i++)
+    {
+        fwrite(NODE_NAME(graph->nodes[i]), 1, strlen(NODE_NAME(graph->nodes[i])) + 1, output);
+        fwrite(NODE_CONTENT(graph->nodes[i]), 1, strlen(NODE_CONTENT(graph->nodes[i])) + 1, output);
+
+        // Whole chunks at a time, the posts are already stored the way the snapshot keeps them
+        if (NODE_POSTS(graph->nodes[i]) != NULL)
+            for (struct post_chunk *chunk = NODE_POSTS(graph->nodes[i])->head; chunk != NULL; chunk = chunk->next)
+                fwrite(chunk->data, 1, chunk->used, output);
+    }
+
+    // The snapshot has to be on the disk before the log it replaces is emptied
+    int written = (fflush(output) == 0) && !ferror(output) && (fsync(fileno(output)) == 0);
+
+    written = (fclose(output) == 0) && written;
+
+    if (written)
+        written = (rename(temp_path, path) == 0);
+    else
+        remove(temp_path);
+
+    free(temp_path);
+
+    if (written)
+    {
+        wal.generation = header.generation;
+        wal_reset(); // Everything logged so far is part of the snapshot now
+    }
+
+    return written;
+}
+
+// Function to add a node to, or take it out of, the indexes given by INDEX_* flags. Returns 0 if memory allocation failed
+static int index_node(void *node, int indexes, int add)
+{
+    enum node_kind kind = NODE_KIND(node);
+    int id = NODE_ID(node);
+    struct tm *birthday = (kind == NODE_INDIVIDUAL) ? ((struct individual *)node)->birthday : NULL;
+    struct post_cursor cursor;
+    char *post;
+
+    if (!add)
+    {
+        if (indexes & INDEX_NAMES)
+            name_index_remove(kind, NODE_NAME(node), node);
+        if (indexes & INDEX_PLACES)
+            spatial_index_remove(node);
+        if (indexes & INDEX_BIRTHDAYS)
+            birthday_index_remove(id, birthday);
+
+        if (indexes & INDEX_WORDS)
+        {
+            word_index_remove(id, NODE_CONTENT(node));
+            trigram_index_remove(id, NODE_CONTENT(node));
+
+            post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+            while ((post = post_log_next(&cursor)) != NULL)
+            {
+                word_index_remove(id, post);
+                trigram_index_remove(id, post);
+            }
+        }
+
+        return 1;
+    }
+
+    if (((indexes & INDEX_NAMES) && !name_index_insert(kind, NODE_NAME(node), node)) ||
+        ((indexes & INDEX_PLACES) && !spatial_index_insert(node)) || ((indexes & INDEX_BIRTHDAYS) && !birthday_index_insert(id, birthday)))
+        return 0;
+
+    if (indexes & INDEX_WORDS)
+    {
+        if (!word_index_add(id, NODE_CONTENT(node)) || !trigram_index_add(id, NODE_CONTENT(node)))
+            return 0;
+
+        post_log_seek(NODE_POSTS(node), 0, &cursor);
+
+        while ((post = post_log_next(&cursor)) != NULL)
+        {
+            if (!word_index_add(id, post) || !trigram_index_add(id, post))
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Function to check the header of a snapshot, i.e that it's sections follow each other and fill up the file
+static int snapshot_valid(struct snapshot_header *header, size_t size)
+{
+    if (size < sizeof(struct snapshot_header) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)))
+        return 0;
+
+    if (header->version != SNAPSHOT_VERSION || header->tm_size != sizeof(struct tm))
+        return 0;
+
+    if (header->node_count < 0 || header->node_count > 2147483647 || header->date_count < 0 || header->link_count < 0 ||
+        header->link_count > 2147483647 || header->string_bytes < 0 || header->time_count < 0 || header->string_bytes > (long long)size)
+        return 0;
+
+    // The sections have to follow each other in the order save_snapshot() writes them
+    if (header->nodes_offset != (long long)sizeof(struct snapshot_header) ||
+        header->dates_offset != header->nodes_offset + header->node_count * (long long)sizeof(struct snapshot_node) ||
+        header->times_offset != header->dates_offset + header->date_count * (long long)sizeof(struct tm) ||
+        header->links_offset != header->times_offset + header->time_count * (long long)sizeof(long long) ||
+        header->twins_offset != header->links_offset + header->link_count * (long long)sizeof(int) ||
+        header->strings_offset != header->twins_offset + header->link_count * (long long)sizeof(int) ||
+        header->strings_offset + header->string_bytes != (long long)size)
+        return 0;
+
+    // The last string has to end inside the file, so that reading any string stops before the end of the mapping
+    char *strings = (char *)header + header->strings_offset;
+
+    return header->string_bytes == 0 || strings[header->string_bytes - 1] == '\0';
+}
+
+// Function to check that a node record of a snapshot only points inside the sections, the strings and dates
+// themselves aren't read
+static int snapshot_record_valid(struct snapshot_header *header, struct snapshot_node *record, long long first_link)
+{
+    if (record->kind < 0 || record->kind > NODE_GROUP || record->creation < 0 || record->creation >= header->date_count ||
+        record->birthday < -1 || record->birthday >= header->date_count ||
+        record->name < 0 || record->name >= header->string_bytes || record->content < 0 || record->content >= header->string_bytes ||
+        record->post_count < 0 || record->post_bytes < 0 || record->posts < 0 || record->posts > header->string_bytes - record->post_bytes ||
+        (record->post_count > 0) != (record->post_bytes > 0) ||
+        record->first_time < 0 || record->first_time > header->time_count - record->post_count)
+        return 0;
+
+    // The posts have to end with a '\0', so that reading them stays inside their own bytes
+    if (record->post_bytes > 0 && ((char *)header + header->strings_offset)[record->posts + record->post_bytes - 1] != '\0')
+        return 0;
+
+    // The links of the nodes follow each other without gaps
+    long long link_total = 0;
+
+    for (int list = 0; list < 3; list++)
+    {
+        if (record->list_sizes[list] < 0)
+            return 0;
+
+        link_total += record->list_sizes[list];
+    }
+
+    return record->first_link == first_link && first_link + link_total <= header->link_count;
+}
+
+// Function to make sure the nodes are in the indexes about to be used, adding them all if a snapshot left them out
+int index_require(int indexes)
+{
+    indexes &= pending_indexes;
+
+    if (indexes == 0)
+        return 1;
+
+    pending_indexes &= ~indexes; // Cleared first, as the inserts below skip the indexes still pending
+
+    void *heads[4] = {all_Individuals, all_business, all_Organisation, all_Group};
+    int added = 1;
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP && added; kind++)
+    {
+        added = !(indexes & INDEX_NAMES) || name_index_reserve(kind, (int)node_pools[kind]->in_use);
+
+        for (void *node = heads[kind]; node != NULL && added; node = NODE_NEXT(node))
+            added = index_node(node, indexes, 1);
+    }
+
+    // The nodes were added front to back, the reverse of the order create_node() adds them in, so the chains are
+    // turned around to find the node nearest the front of it's list first, as they would have if the nodes were created
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP && added && (indexes & INDEX_NAMES); kind++)
+        name_index_reverse(kind);
+
+    if (added)
+        return 1;
+
+    // Taking every node back out, the one that failed may be partly added and taking out one never added does nothing
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+        for (void *node = heads[kind]; node != NULL; node = NODE_NEXT(node))
+            index_node(node, indexes, 0);
+
+    pending_indexes |= indexes;
+
+    printf("Memory allocation failed. Please try again\n");
+    return 0;
+}
+
+// Function to free the nodes made from a snapshot that couldn't be loaded, they are only in the ID index
+static void snapshot_rollback(void **nodes, int first, int node_count)
+{
+    for (int i = first; i < node_count; i++)
+    {
+        id_index_remove(NODE_ID(nodes[i]));
+        post_log_free(NODE_POSTS(nodes[i]));
+        node_list_unlink(nodes[i]);
+        pool_free(node_pools[NODE_KIND(nodes[i])], nodes[i]);
+    }
+}
+
+// Function to load a snapshot file into an empty network
+int load_snapshot(char *path)
+{
+    if (network_size() != 0 || loaded_snapshot.base != NULL)
+        return 0; // Only a fresh network can be replaced by a snapshot
+
+    int descriptor = open(path, O_RDONLY);
+
+    if (descriptor < 0)
+        return 0;
+
+    struct stat file_info;
+
+    if (fstat(descriptor, &file_info) < 0 || file_info.st_size < (off_t)sizeof(struct snapshot_header))
+    {
+        close(descriptor);
+        return 0;
+    }
+
+    size_t size = (size_t)file_info.st_size;
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    close(descriptor); // The mapping stays valid without the descriptor
+
+    if (base == MAP_FAILED)
+        return 0;
+
+    struct snapshot_header *header = (struct snapshot_header *)base;
+
+    if (!snapshot_valid(header, size))
+    {
+        munmap(base, size);
+        return 0;
+    }
+
+    struct snapshot_node *records = (struct snapshot_node *)((char *)base + header->nodes_offset);
+    struct tm *dates = (struct tm *)((char *)base + header->dates_offset);
+    long long *times = (long long *)((char *)base + header->times_offset);
+    int *links = (int *)((char *)base + header->links_offset);
+    int *twins = (int *)((char *)base + header->twins_offset);
+    char *strings = (char *)base + header->strings_offset;
+
+    int node_count = (int)header->node_count;
+    int valid = 1;
+
+    // Checking every offset before anything is made from the snapshot, reading only the records and links which are
+    // needed to build the nodes anyway. The strings, dates and times aren't touched
+    int counts[4] = {0, 0, 0, 0};
+    size_t cells[4] = {0, 0, 0, 0};
+    long long next_link = 0;
+
+    for (int i = 0; valid && i < node_count; i++)
+    {
+        valid = snapshot_record_valid(header, &records[i], next_link);
+
+        if (valid)
+        {
+            counts[records[i].kind]++;
+            next_link += records[i].list_sizes[0] + records[i].list_sizes[1] + records[i].list_sizes[2];
+        }
+    }
+
+    valid = valid && next_link == header->link_count;
+
+    // The twin of a cell has to be a cell in the lists of the node the cell points to, pointing back to the cell
+    for (int i = 0; valid && i < node_count; i++)
+    {
+        long long end = records[i].first_link + records[i].list_sizes[0] + records[i].list_sizes[1] + records[i].list_sizes[2];
+
+        for (long long j = records[i].first_link; valid && j < end; j++)
+        {
+            valid = links[j] >= 0 && links[j] < node_count && twins[j] >= 0 && twins[j] < header->link_count &&
+                    twins[twins[j]] == j && links[twins[j]] == i;
+
+            if (valid)
+                cells[records[links[j]].kind]++;
+        }
+    }
+
+    if (!valid)
+    {
+        munmap(base, size);
+        return 0;
+    }
+
+    void **nodes = (void **)malloc((node_count + 1) * sizeof(void *));
+    struct linked_cell **link_cells = (struct linked_cell **)malloc((header->link_count + 1) * sizeof(struct linked_cell *)); // Position in the links section -> cell
+
+    // Sizing the pools for everything in the snapshot at once, so that taking a node or cell from them can't fail
+    int reserved = (nodes != NULL && link_cells != NULL && id_index_reserve(node_count));
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+        reserved = reserved && pool_reserve(node_pools[kind], counts[kind]) && pool_reserve(linked_pools[kind], cells[kind]);
+
+    loaded_snapshot.base = base;
+    loaded_snapshot.size = size;
+
+    // The nodes are made from the last to the first, as node_alloc() adds them to the front of the global lists.
+    // Only the ID index is filled in, as the ids have to be checked to be unique before the snapshot can be used. It
+    // reads nothing but the records, the other indexes are built from the global lists the first time they are used
+    int first = node_count;
+
+    while (reserved && first > 0)
+    {
+        struct snapshot_node *record = &records[first - 1];
+
+        // The strings and dates are used right where they are in the mapping
+        void *node = node_alloc(record->kind, record->id, strings + record->name, &dates[record->creation], strings + record->content,
+                                record->birthday >= 0 ? &dates[record->birthday] : NULL, record->x_cord, record->y_cord);
+
+        if (node == NULL)
+            break;
+
+        nodes[--first] = node;
+
+        if (!id_index_insert(record->id, record->kind, node))
+            break;
+
+        // The posts are used right where they are too, as a single full chunk
+        if (record->post_count > 0 && post_log_map(NODE_FIELD(node, struct post_log *, posts), strings + record->posts, record->post_count,
+                                                   record->post_bytes, times + record->first_time) < 0)
+            break;
+    }
+
+    if (!reserved || first > 0)
+    {
+        snapshot_rollback(nodes, first, node_count);
+
+        loaded_snapshot.base = NULL;
+        loaded_snapshot.size = 0;
+        munmap(base, size);
+
+        free(nodes);
+        free(link_cells);
+        return 0;
+    }
+
+    // Rebuilding the link lists in the order they were saved in
+    for (int i = 0; i < node_count; i++)
+    {
+        struct linked_cell **heads[3];
+        int list_count = node_list_heads(nodes[i], heads);
+        long long link = records[i].first_link;
+
+        for (int list = 0; list < list_count; list++)
+        {
+            struct linked_cell **tail = heads[list];
+
+            for (int j = 0; j < records[i].list_sizes[list]; j++, link++)
+            {
+                struct linked_cell *cell = (struct linked_cell *)pool_alloc(linked_pools[records[links[link]].kind]);
+
+                cell->node = nodes[links[link]];
+                cell->next = NULL;
+                cell->pprev = tail;
+
+                *tail = cell;
+                tail = &cell->next;
+
+                link_cells[link] = cell;
+            }
+        }
+    }
+
+    for (long long link = 0; link < header->link_count; link++)
+        link_cells[link]->twin = link_cells[twins[link]];
+
+    free(nodes);
+    free(link_cells);
+
+    wal.generation = header->generation;
+    pending_indexes = INDEX_ALL;
+
+    csr_mark_stale();
+    components_mark_dirty();                                            // The links were made without link_member()
+    content_arena_mark_stale();
+
+    return 1;
+}
+
+// Batch command engine
+
+// Function to read a whole line, growing the buffer as needed
+static char *read_line(FILE *input, char **buffer, size_t *capacity)
+{
+    size_t size = 0;
+
+    if (*buffer == NULL)
+    {
+        *capacity = 256;
+        *buffer = (char *)malloc(*capacity);
+
+        if (*buffer == NULL)
+            return NULL;
+    }
+
+    while (fgets(*buffer + size, (int)(*capacity - size), input) != NULL)
+    {
+        size += strlen(*buffer + size);
+
+        if (size > 0 && (*buffer)[size - 1] == '\n')                        // The whole line has been read
+            break;
+
+        if (size + 1 < *capacity)                                           // End of the input without a new line
+            break;
+
+        // Line doesn't fit, so the buffer is doubled
+        char *temp = (char *)realloc(*buffer, *capacity * 2);
+
+        if (temp == NULL)
+            return NULL;
+
+        *buffer = temp;
+        *capacity *= 2;
+    }
+
+    if (size == 0)
+        return NULL;                                                        // Nothing left to read
+
+    // Removing the line ending
+    while (size > 0 && ((*buffer)[size - 1] == '\n' || (*buffer)[size - 1] == '\r'))
+        (*buffer)[--size] = '\0';
+
+    return *buffer;
+}
+
+// Function to undo in place the escaping wal_record() put on a field of the operation log
+static void unescape_field(char *field)
+{
+    char *to = field;
+
+    for (char *from = field; *from != '\0'; from++)
+    {
+        if (*from == '\\' && from[1] != '\0')
+        {
+            from++;
+            *to++ = (*from == 'n') ? '\n' : (*from == 'r') ? '\r' : *from;
+        }
+        else
+            *to++ = *from;
+    }
+
+    *to = '\0';
+}
+
+// Function to split the next field off a line at the given separator
+static char *split_field(char **cursor, char separator)
+{
+    if (*cursor == NULL)
+        return NULL;
+
+    char *field = *cursor;
+    char *end;
+
+    // The operation log escapes the separator inside names and contents, so a backslash skips the character after it
+    if (wal.replaying)
+    {
+        for (end = field; *end != '\0' && *end != separator; end++)
+            if (*end == '\\' && end[1] != '\0')
+                end++;
+
+        if (*end == '\0')
+            end = NULL;
+    }
+    else
+        end = strchr(field, separator);
+
+    if (end != NULL)
+    {
+        *end = '\0';
+        *cursor = end + 1;
+    }
+    else
+        *cursor = NULL;
+
+    if (wal.replaying)
+        unescape_field(field);
+
+    return field;
+}
+
+// Function to split the next '|' separated field off a command
+static char *next_field(char **cursor)
+{
+    return split_field(cursor, '|');
+}
+
+// Function to take the rest of a command as a single field, so that it may contain '|'
+static char *rest_field(char **cursor)
+{
+    char *field = *cursor;
+    *cursor = NULL;
+
+    if (field != NULL && wal.replaying)
+        unescape_field(field);
+
+    return field;
+}
+
+// Function to read an integer field, returns 0 if it isn't one
+static int int_field(char *field, int *value)
+{
+    if (field == NULL || *field == '\0')
+        return 0;
+
+    char *end;
+    long number = strtol(field, &end, 10);
+
+    if (*end != '\0')
+        return 0;
+
+    *value = (int)number;
+    return 1;
+}
+
+// Function to read a double field, returns 0 if it isn't one
+static int double_field(char *field, double *value)
+{
+    if (field == NULL || *field == '\0')
+        return 0;
+
+    char *end;
+    *value = strtod(field, &end);
+
+    return *end == '\0';
+}
+
+// Function to read a date field of the format DD/MM/YYYY into a new date, an invalid date is stored as -1
+static struct tm *date_field(char *field)
+{
+    struct tm *temp_date = (struct tm *)calloc(1, sizeof(struct tm));
+
+    if (temp_date == NULL)
+        return NULL;
+
+    if (field == NULL || sscanf(field, "%d/%d/%d", &(temp_date->tm_mday), &(temp_date->tm_mon), &(temp_date->tm_year)) != 3)
+    {
+        temp_date->tm_mday = -1;
+        temp_date->tm_mon = -1;
+        temp_date->tm_year = -1;
+    }
+
+    return temp_date;
+}
+
+// Function to copy a field into a string of it's own
+static char *string_field(char *field)
+{
+    char *copy = (char *)malloc(strlen(field) + 1);
+
+    if (copy != NULL)
+        strcpy(copy, field);
+
+    return copy;
+}
+
+// Function to create a node from the fields of a line, returns an error message or NULL on success
+static char *create_from_fields(char **cursor, char separator)
+{
+    char *type = split_field(cursor, separator);
+    int kind = (type == NULL) ? -1 : kind_from_type(type);
+
+    if (kind < 0)
+        return "unknown type";
+
+    int id;
+
+    if (!int_field(split_field(cursor, separator), &id))
+        return "invalid id";
+
+    if (id_index_find(id) != NULL)
+        return "id already exists";
+
+    char *name = split_field(cursor, separator);
+    char *creation = split_field(cursor, separator);
+
+    // The unique attributes come before the content
+    char *birthday = NULL;
+    double x_cord = 0, y_cord = 0;
+
+    if (kind == NODE_INDIVIDUAL)
+        birthday = split_field(cursor, separator);
+    else if (!double_field(split_field(cursor, separator), &x_cord) || !double_field(split_field(cursor, separator), &y_cord))
+        return "invalid co-ordinates";
+
+    char *content = rest_field(cursor);
+
+    if (name == NULL || creation == NULL || content == NULL)
+        return "missing attributes";
+
+    char *node_name = string_field(name);
+    char *node_content = string_field(content);
+    struct tm *node_creation = date_field(creation);
+    struct tm *node_birthday = (kind == NODE_INDIVIDUAL) ? date_field(birthday) : NULL;
+
+    if (node_name == NULL || node_content == NULL || node_creation == NULL || (kind == NODE_INDIVIDUAL && node_birthday == NULL) ||
+        create_node(kind, id, node_name, node_creation, node_content, node_birthday, x_cord, y_cord) == NULL)
+    {
+        free(node_name);
+        free(node_content);
+        free(node_creation);
+        free(node_birthday);
+
+        return "memory allocation failed";
+    }
+
+    return NULL;
+}
+
+// Function to run the create command
+static char *batch_create(char *cursor)
+{
+    return create_from_fields(&cursor, '|');
+}
+
+// Function to run the link command
+static char *batch_link(char *cursor)
+{
+    int container_id, member_id;
+
+    if (!int_field(next_field(&cursor), &container_id) || !int_field(next_field(&cursor), &member_id))
+        return "invalid id";
+
+    struct id_slot *container = id_index_find(container_id);
+    struct id_slot *member = id_index_find(member_id);
+
+    if (container == NULL || member == NULL)
+        return "no such node";
+
+    // The role is only given for businesses
+    char *role_name = next_field(&cursor);
+    enum link_role role = LINK_MEMBER;
+
+    if (role_name != NULL && !strcmp(role_name, "owner"))
+        role = LINK_OWNER;
+    else if (role_name != NULL && !strcmp(role_name, "customer"))
+        role = LINK_CUSTOMER;
+    else if (role_name != NULL && strcmp(role_name, "member"))
+        return "unknown role";
+
+    if (!link_member(container->node, member->node, role))
+        return "these nodes can't be linked";
+
+    return NULL;
+}
+
+// Function to run the post command
+static char *batch_post(char *cursor)
+{
+    int id;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    char *text = rest_field(&cursor);
+
+    if (text == NULL)
+        return "missing content";
+
+    int result = post_content(id, text);
+
+    if (result == 0)
+        return "no such node";
+    if (result < 0)
+        return "memory allocation failed";
+
+    return NULL;
+}
+
+// Function to run the post-at command, a post made at a given time
+static char *batch_post_at(char *cursor)
+{
+    int id;
+    char *time_text, *end;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if ((time_text = next_field(&cursor)) == NULL || *time_text == '\0')
+        return "invalid time";
+
+    long long time = strtoll(time_text, &end, 10);
+
+    if (*end != '\0')
+        return "invalid time";
+
+    char *text = rest_field(&cursor);
+
+    if (text == NULL)
+        return "missing content";
+
+    int result = post_content_at(id, text, time);
+
+    if (result == 0)
+        return "no such node";
+    if (result < 0)
+        return "memory allocation failed";
+
+    return NULL;
+}
+
+// Function to run the feed command, printing the latest posts of the one-hop nodes of a node
+static char *batch_feed(char *cursor)
+{
+    int id, count;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if (!int_field(next_field(&cursor), &count) || count < 0)
+        return "invalid count";
+
+    count = feed_collect(id, count);
+
+    if (count < 0)
+        return "no such node";
+
+    for (int i = 0; i < count; i++)
+        printf("%d|%lld|%s\n", feed_items[i].id, feed_items[i].time, feed_items[i].post);
+
+    return NULL;
+}
+
+// Function to read the type field of the spatial commands, "any" for all the types with coordinates
+static int place_kind_field(char *field, int *kind)
+{
+    if (field == NULL)
+        return 0;
+
+    if (!strcmp(field, "any"))
+    {
+        *kind = -1;
+        return 1;
+    }
+
+    *kind = kind_from_type(field);
+
+    return *kind > NODE_INDIVIDUAL;
+}
+
+// Function to print the ids of the places found by the last spatial query
+static void print_found_places(int count)
+{
+    char *separator = "";
+
+    for (int i = 0; i < count; i++)
+    {
+        printf("%s%d", separator, found_places[i].id);
+        separator = " ";
+    }
+
+    printf("\n");
+}
+
+// Function to run the near command, prints the ids of the nodes nearest to a node
+static char *batch_near(char *cursor)
+{
+    int id, kind, count;
+    double x, y;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if (!place_kind_field(next_field(&cursor), &kind))
+        return "invalid type";
+
+    if (!int_field(next_field(&cursor), &count) || count < 0)
+        return "invalid count";
+
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return "no such node";
+
+    if (!node_position(slot->node, &x, &y))
+        return "node has no coordinates";
+
+    print_found_places(places_nearest(kind, x, y, count, id));
+
+    return NULL;
+}
+
+// Function to run the within command, prints the ids of the nodes within a radius of a point
+static char *batch_within(char *cursor)
+{
+    int kind;
+    double x, y, radius;
+
+    if (!place_kind_field(next_field(&cursor), &kind))
+        return "invalid type";
+
+    if (!double_field(next_field(&cursor), &x) || !double_field(next_field(&cursor), &y))
+        return "invalid point";
+
+    if (!double_field(next_field(&cursor), &radius) || radius < 0)
+        return "invalid radius";
+
+    print_found_places(places_within(kind, x, y, radius));
+
+    return NULL;
+}
+
+// Function to run the box command, prints the ids of the nodes inside a box
+static char *batch_box(char *cursor)
+{
+    int kind;
+    double x1, y1, x2, y2;
+
+    if (!place_kind_field(next_field(&cursor), &kind))
+        return "invalid type";
+
+    if (!double_field(next_field(&cursor), &x1) || !double_field(next_field(&cursor), &y1) ||
+        !double_field(next_field(&cursor), &x2) || !double_field(next_field(&cursor), &y2))
+        return "invalid box";
+
+    print_found_places(places_in_box(kind, x1, y1, x2, y2));
+
+    return NULL;
+}
+
+// Function to print the ids of the nodes in found_nodes[]
+static void print_found_ids(int count)
+{
+    for (int i = 0; i < count; i++)
+        printf(i == 0 ? "%d" : " %d", NODE_ID(found_nodes[i]));
+
+    printf("\n");
+}
+
+// Function to read a date field of the format DD/MM/YYYY into it's day, month and year
+static int day_field(char *field, int *day, int *month, int *year)
+{
+    int length = 0;
+
+    return field != NULL && sscanf(field, "%d/%d/%d%n", day, month, year, &length) == 3 && field[length] == '\0';
+}
+
+// Function to read a day field of the format DD/MM
+static int month_day_field(char *field, int *day, int *month)
+{
+    int length = 0;
+
+    return field != NULL && sscanf(field, "%d/%d%n", day, month, &length) == 2 && field[length] == '\0';
+}
+
+// Function to run the birthday command, prints the ids of the individuals born on a date
+static char *batch_birthday(char *cursor)
+{
+    int day, month, year;
+
+    if (!day_field(next_field(&cursor), &day, &month, &year))
+        return "invalid date";
+
+    int count = birthdays_on(day, month, year);
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    print_found_ids(count);
+
+    return NULL;
+}
+
+// Function to run the birthday-any command, prints the ids of the individuals born on a day of any year
+static char *batch_birthday_any(char *cursor)
+{
+    int day, month;
+
+    if (!month_day_field(next_field(&cursor), &day, &month))
+        return "invalid day";
+
+    int count = birthdays_on_day(day, month);
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    print_found_ids(count);
+
+    return NULL;
+}
+
+// Function to run the upcoming command, prints the ids of the individuals having their birthday in the days from a date
+static char *batch_upcoming(char *cursor)
+{
+    struct tm from = {0};
+    int days;
+
+    if (!day_field(next_field(&cursor), &from.tm_mday, &from.tm_mon, &from.tm_year))
+        return "invalid date";
+
+    if (!int_field(next_field(&cursor), &days) || days < 0)
+        return "invalid number of days";
+
+    int count = upcoming_birthdays(&from, days);
+
+    if (count < 0)
+        return "invalid date";
+
+    print_found_ids(count);
+
+    return NULL;
+}
+
+// Function to run the search command, prints the ids of the nodes with the given name or type
+static char *batch_search(char *cursor)
+{
+    char *search_parameter = rest_field(&cursor);
+
+    if (search_parameter == NULL)
+        return "missing name";
+
+    int search_kind = kind_from_type(search_parameter);
+    char *separator = "";
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+    {
+        for (struct name_entry *entry = name_index_find(kind, search_parameter); entry != NULL; entry = name_index_next(entry))
+        {
+            printf("%s%d", separator, NODE_ID(entry->node));
+            separator = " ";
+        }
+    }
+
+    // All the nodes of the type, if the parameter is one
+    if (search_kind >= 0)
+    {
+        struct csr_graph *graph = csr_snapshot();
+
+        if (graph == NULL)
+            return "memory allocation failed";
+
+        for (int i = 0; i < graph->node_count; i++)
+        {
+            if (graph->kinds[i] == search_kind && strcmp(search_parameter, NODE_NAME(graph->nodes[i])))
+            {
+                printf("%s%d", separator, NODE_ID(graph->nodes[i]));
+                separator = " ";
+            }
+        }
+    }
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to run the one-hop command, prints the ids of the one-hop nodes
+static char *batch_one_hop(char *cursor)
+{
+    int id;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return "no such node";
+
+    struct csr_graph *graph = csr_snapshot();
+
+    if (graph == NULL)
+        return "memory allocation failed";
+
+    int index = NODE_CSR_INDEX(slot->node);
+
+    for (int i = graph->offsets[index]; i < graph->offsets[index + 1]; i++)
+        printf(i == graph->offsets[index] ? "%d" : " %d", NODE_ID(graph->nodes[graph->neighbors[i]]));
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to run the two-hop command, prints the ids of the two-hop nodes
+static char *batch_two_hop(char *cursor)
+{
+    int id;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return "no such node";
+
+    if (slot->kind != NODE_INDIVIDUAL)
+        return "not an individual";
+
+    int count = two_hop_collect((struct individual *)slot->node);
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    // Same order in which two_hop() prints them
+    for (int i = count - 1; i >= 0; i--)
+        printf(i == count - 1 ? "%d" : " %d", NODE_ID(membership_graph.nodes[two_hop_buffer[i]]));
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to run the k-hop command, prints the ids of the nodes within a number of hops, nearest first
+static char *batch_k_hop(char *cursor, int counts_only)
+{
+    int id, hops;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if (!int_field(next_field(&cursor), &hops) || hops < 0)
+        return "invalid number of hops";
+
+    int count = k_hop_collect(id, hops);
+
+    if (count < 0)
+        return id_index_find(id) == NULL ? "no such node" : "memory allocation failed";
+
+    if (counts_only)
+    {
+        // The number of nodes at each distance, up to the farthest node reached
+        for (int level = 1; level <= hops && k_hop_ends[level - 1] <= count; level++)
+            printf(level == 1 ? "%d" : " %d", k_hop_ends[level] - k_hop_ends[level - 1]);
+    }
+    else
+    {
+        for (int i = 1; i <= count; i++)
+            printf(i == 1 ? "%d" : " %d", NODE_ID(membership_graph.nodes[k_hop_nodes[i]]));
+    }
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to run the path command, prints the ids of the nodes on the shortest path between two nodes
+static char *batch_path(char *cursor)
+{
+    int from, to;
+
+    if (!int_field(next_field(&cursor), &from) || !int_field(next_field(&cursor), &to))
+        return "invalid id";
+
+    int length = shortest_path(from, to);
+
+    if (length == -2)
+        return (id_index_find(from) == NULL || id_index_find(to) == NULL) ? "no such node" : "memory allocation failed";
+
+    // An empty line if the nodes aren't connected
+    for (int i = 0; i <= length; i++)
+        printf(i == 0 ? "%d" : " %d", NODE_ID(membership_graph.nodes[path_nodes[i]]));
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to run the connected command, prints 1 if the two nodes are connected and 0 otherwise
+static char *batch_connected(char *cursor)
+{
+    int a, b;
+
+    if (!int_field(next_field(&cursor), &a) || !int_field(next_field(&cursor), &b))
+        return "invalid id";
+
+    int connected = nodes_connected(a, b);
+
+    if (connected < 0)
+        return (id_index_find(a) == NULL || id_index_find(b) == NULL) ? "no such node" : "memory allocation failed";
+
+    printf("%d\n", connected);
+
+    return NULL;
+}
+
+// Function to run the components command, prints <smallest id>:<size> for every connected component
+static char *batch_components(char *cursor)
+{
+    (void)cursor; // Takes no fields
+
+    int count = components_collect();
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    for (int i = 0; i < count; i++)
+        printf(i == 0 ? "%d:%d" : " %d:%d", found_components[i].id, found_components[i].size);
+
+    printf("\n");
+
+    return NULL;
+}
+
+// Function to read the optional damping, tolerance and iterations fields of the PageRank commands
+static int pagerank_fields(char *cursor, double *damping, double *tolerance, int *iterations)
+{
+    char *field;
+
+    *damping = 0.85;
+    *tolerance = 1e-6;
+    *iterations = 100;
+
+    if ((field = next_field(&cursor)) != NULL && (!double_field(field, damping) || *damping < 0 || *damping >= 1))
+        return 0;
+
+    if ((field = next_field(&cursor)) != NULL && (!double_field(field, tolerance) || *tolerance < 0))
+        return 0;
+
+    if ((field = next_field(&cursor)) != NULL && (!int_field(field, iterations) || *iterations < 0))
+        return 0;
+
+    return 1;
+}
+
+// Function to run the pagerank command, prints the number of iterations run
+static char *batch_pagerank(char *cursor)
+{
+    double damping, tolerance;
+    int iterations;
+
+    if (!pagerank_fields(cursor, &damping, &tolerance, &iterations))
+        return "invalid parameters";
+
+    iterations = pagerank_compute(damping, tolerance, iterations);
+
+    if (iterations < 0)
+        return "memory allocation failed";
+
+    printf("%d\n", iterations);
+
+    return NULL;
+}
+
+// Function to run the pagerank-refresh command
+static char *batch_pagerank_refresh(char *cursor)
+{
+    double damping, tolerance;
+    int iterations;
+
+    if (!pagerank_fields(cursor, &damping, &tolerance, &iterations))
+        return "invalid parameters";
+
+    if (pagerank_background.running)
+        return "a computation is already running";
+
+    if (!pagerank_refresh(damping, tolerance, iterations))
+        return "could not start the computation";
+
+    return NULL;
+}
+
+// Function to run the top command, prints the ids of the nodes with the highest scores
+static char *batch_top(char *cursor)
+{
+    char *type = next_field(&cursor);
+    int kind, count;
+
+    if (type == NULL)
+        return "invalid type";
+
+    // Unlike the spatial commands, individuals are scored too
+    kind = strcmp(type, "any") ? kind_from_type(type) : -1;
+
+    if (kind == -1 && strcmp(type, "any"))
+        return "invalid type";
+
+    if (!int_field(next_field(&cursor), &count) || count < 0)
+        return "invalid count";
+
+    count = top_scores(kind, count);
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    print_found_ids(count);
+
+    return NULL;
+}
+
+// Function to run the score command, prints the score of a node
+static char *batch_score(char *cursor)
+{
+    int id;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    struct id_slot *slot = id_index_find(id);
+
+    if (slot == NULL)
+        return "no such node";
+
+    printf("%.9f\n", NODE_SCORE(slot->node));
+
+    return NULL;
+}
+
+// Function to run the threads command, sets the number of threads the traversals run on
+static char *batch_threads(char *cursor)
+{
+    int threads;
+
+    if (!int_field(next_field(&cursor), &threads) || threads < 1)
+        return "invalid number of threads";
+
+    if (!thread_pool_start(threads))
+        return "could not start the threads";
+
+    return NULL;
+}
+
+// Function to run the delete command
+static char *batch_delete(char *cursor)
+{
+    int id;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if (!remove_node(id))
+        return "no such node";
+
+    return NULL;
+}
+
+// Bulk loader
+
+// Function to check if link_member() can link two kinds of nodes in a given role
+static int can_link(enum node_kind container_kind, enum node_kind member_kind, enum link_role role)
+{
+    if (container_kind == NODE_BUSINESS)
+        return member_kind == NODE_INDIVIDUAL && role != LINK_MEMBER;
+    if (container_kind == NODE_ORGANISATION)
+        return member_kind == NODE_INDIVIDUAL && role == LINK_MEMBER;
+    if (container_kind == NODE_GROUP)
+        return (member_kind == NODE_INDIVIDUAL || member_kind == NODE_BUSINESS) && role == LINK_MEMBER;
+
+    return 0;
+}
+
+// Function to end the hold a bulk load put on the log, syncing everything it logged at once
+static void wal_release()
+{
+    wal.held--;
+
+    if (wal.held == 0 && wal.sync_every > 0 && wal.pending > 0)
+        wal_sync();
+}
+
+// Function to load the nodes in a CSV file
+int load_nodes(FILE *input)
+{
+    setvbuf(input, NULL, _IOFBF, 1 << 16);
+
+    char *line = NULL;
+    size_t capacity = 0;
+    int counts[4] = {0, 0, 0, 0};
+
+    // First pass only counts the nodes of each kind, so that everything can be sized up front
+    while (read_line(input, &line, &capacity) != NULL)
+    {
+        char *cursor = line;
+        char *type = split_field(&cursor, ',');
+        int kind = kind_from_type(type);
+
+        if (kind >= 0)
+            counts[kind]++;
+    }
+
+    int total = counts[NODE_INDIVIDUAL] + counts[NODE_BUSINESS] + counts[NODE_ORGANISATION] + counts[NODE_GROUP];
+    if (!id_index_reserve(all_Ids.used + total))
+    {
+        free(line);
+        return -1;
+    }
+
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+    {
+        if (!name_index_reserve(kind, all_Names[kind].count + counts[kind]) || !pool_reserve(node_pools[kind], counts[kind]))
+        {
+            free(line);
+            return -1;
+        }
+    }
+
+    rewind(input);
+
+    int line_number = 0;
+    int loaded = 0;
+    int errors = 0;
+
+    // Second pass creates the nodes, none of the indexes or pools have to grow now. Every node is still logged, but
+    // the log is synced once for the whole file
+    wal.held++;
+
+    while (read_line(input, &line, &capacity) != NULL)
+    {
+        line_number++;
+
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+
+        char *cursor = line;
+        char *error = create_from_fields(&cursor, ',');
+
+        if (error != NULL)
+        {
+            fprintf(stderr, "line %d: %s\n", line_number, error);
+            errors++;
+        }
+        else
+            loaded++;
+    }
+
+    free(line);
+    wal_release();
+
+    fprintf(stderr, "%d node(s) loaded, %d error(s)\n", loaded, errors);
+
+    return errors;
+}
+
+// Function to read an id off an edge list line, skipping the separators in front of it
+static int edge_id(char **cursor, int *id)
+{
+    while (**cursor == ' ' || **cursor == '\t' || **cursor == ',')
+        (*cursor)++;
+
+    char *end;
+    long number = strtol(*cursor, &end, 10);
+
+    if (end == *cursor)
+        return 0;
+
+    *id = (int)number;
+    *cursor = end;
+
+    return 1;
+}
+
+// Function to load the links in an edge list file
+int load_edges(FILE *input)
+{
+    setvbuf(input, NULL, _IOFBF, 1 << 16);
+
+    char *line = NULL;
+    size_t capacity = 0;
+
+    struct loaded_link *links = NULL;
+    int link_count = 0;
+    int link_capacity = 0;
+    size_t cells[4] = {0, 0, 0, 0};
+
+    int line_number = 0;
+    int errors = 0;
+
+    // Single pass over the file that resolves both ends of every link through the ID index
+    while (read_line(input, &line, &capacity) != NULL)
+    {
+        line_number++;
+
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+
+        char *cursor = line;
+        char *error = NULL;
+        int container_id, member_id;
+        struct id_slot *container = NULL, *member = NULL;
+        enum link_role role = LINK_MEMBER;
+
+        if (!edge_id(&cursor, &container_id) || !edge_id(&cursor, &member_id))
+            error = "invalid id";
+        else if ((container = id_index_find(container_id)) == NULL || (member = id_index_find(member_id)) == NULL)
+            error = "no such node";
+        else
+        {
+            while (*cursor == ' ' || *cursor == '\t' || *cursor == ',')
+                cursor++;
+
+            if (!strcmp(cursor, "owner"))
+                role = LINK_OWNER;
+            else if (!strcmp(cursor, "customer"))
+                role = LINK_CUSTOMER;
+            else if (*cursor != '\0' && strcmp(cursor, "member"))
+                error = "unknown role";
+            else if (!can_link(container->kind, member->kind, role))
+                error = "these nodes can't be linked";
+        }
+
+        if (error != NULL)
+        {
+            fprintf(stderr, "line %d: %s\n", line_number, error);
+            errors++;
+            continue;
+        }
+
+        if (link_count == link_capacity)
+        {
+            int new_capacity = link_capacity ? link_capacity * 2 : 1024;
+            struct loaded_link *temp = (struct loaded_link *)realloc(links, new_capacity * sizeof(struct loaded_link));
+
+            if (temp == NULL)
+            {
+                printf("Memory allocation failed. Please try again\n");
+                free(links);
+                free(line);
+                return -1;
+            }
+
+            links = temp;
+            link_capacity = new_capacity;
+        }
+
+        links[link_count].container = container->node;
+        links[link_count].member = member->node;
+        links[link_count].role = role;
+        link_count++;
+
+        // Every link takes a cell pointing to the member and a back pointer cell pointing to the container
+        cells[member->kind]++;
+        cells[container->kind]++;
+    }
+
+    free(line);
+
+    // Sizing the cell pools for all the links at once
+    for (int kind = NODE_INDIVIDUAL; kind <= NODE_GROUP; kind++)
+    {
+        if (!pool_reserve(linked_pools[kind], cells[kind]))
+        {
+            free(links);
+            return -1;
+        }
+    }
+
+    wal.held++;
+
+    for (int i = 0; i < link_count; i++)
+        link_member(links[i].container, links[i].member, links[i].role);
+
+    wal_release();
+
+    free(links);
+
+    fprintf(stderr, "%d link(s) loaded, %d error(s)\n", link_count, errors);
+
+    return errors;
+}
+
+// Function to run the load command
+static char *batch_load(char *cursor)
+{
+    char *what = next_field(&cursor);
+    char *path = rest_field(&cursor);
+
+    if (what == NULL || path == NULL)
+        return "missing file";
+
+    if (!strcmp(what, "snapshot"))
+        return load_snapshot(path) ? NULL : "could not load the snapshot";
+
+    int is_nodes = !strcmp(what, "nodes");
+
+    if (!is_nodes && strcmp(what, "edges"))
+        return "can only load nodes, edges or a snapshot";
+
+    FILE *input = fopen(path, "r");
+
+    if (input == NULL)
+        return "could not open file";
+
+    int errors = is_nodes ? load_nodes(input) : load_edges(input);
+
+    fclose(input);
+
+    if (errors < 0)
+        return "memory allocation failed";
+    if (errors > 0)
+        return "some lines could not be loaded";
+
+    return NULL;
+}
+
+// Function to run the delete-many command, the ids are separated by spaces or ','
+static char *batch_delete_many(char *cursor)
+{
+    char *list = rest_field(&cursor);
+
+    if (list == NULL)
+        return "missing ids";
+
+    int *ids = (int *)malloc((strlen(list) / 2 + 1) * sizeof(int)); // Every id takes atleast two characters with it's separator
+    int count = 0;
+
+    if (ids == NULL)
+        return "memory allocation failed";
+
+    while (edge_id(&list, &ids[count]))
+        count++;
+
+    while (*list == ' ' || *list == '\t' || *list == ',')
+        list++;
+
+    if (*list != '\0')
+    {
+        free(ids);
+        return "invalid id";
+    }
+
+    int removed = remove_nodes(ids, count);
+
+    free(ids);
+
+    if (removed < count)
+        return "some nodes didn't exist";
+
+    return NULL;
+}
+
+// Function to run the compact command
+static char *batch_compact(char *cursor)
+{
+    (void)cursor; // Takes no fields
+
+    compact_memory();
+
+    return NULL;
+}
+
+// Function to run the content and words commands, prints the ids of the nodes found
+static char *batch_content(char *cursor, int whole_words)
+{
+    char *query = rest_field(&cursor);
+
+    if (query == NULL)
+        return "missing query";
+
+    int count = content_search(query, whole_words);
+
+    if (count < 0)
+        return "memory allocation failed";
+
+    print_found_ids(count);
+
+    return NULL;
+}
+
+// Function to read a monotonic clock in seconds, for timing
+static double seconds_now()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Function to run the bench command, timing a scan of every content with strstr() and with each substring kernel
+static char *batch_bench(char *cursor)
+{
+    char *pattern = next_field(&cursor);
+    char *rounds_text = next_field(&cursor);
+    int rounds = 10;
+
+    if (pattern == NULL)
+        return "missing string";
+
+    if (rounds_text != NULL && (!int_field(rounds_text, &rounds) || rounds <= 0))
+        return "invalid rounds";
+
+    struct csr_graph *graph = csr_snapshot();
+    struct content_arena *arena = graph == NULL ? NULL : content_arena_build(graph);
+
+    if (arena == NULL)
+        return "memory allocation failed";
+
+    double bytes = (double)arena->size * rounds; // The same contents are scanned either way
+
+    // The way search_for_content() used to scan, one node (and post) at a time
+    int matches = 0;
+    double start = seconds_now();
+
+    for (int round = 0; round < rounds; round++)
+    {
+        matches = 0;
+
+        for (int i = 0; i < graph->node_count; i++)
+            if (node_contains(graph->nodes[i], pattern))
+                matches++;
+    }
+
+    double elapsed = seconds_now() - start;
+
+    printf("%-8s %d match(es) %8.3f GB/s\n", "strstr", matches, elapsed > 0 ? bytes / elapsed / 1e9 : 0.0);
+
+    for (int k = 0; k < substring_kernel_count; k++)
+    {
+        const struct substring_kernel *kernel = &substring_kernels[k];
+
+        if (!kernel->supported())
+        {
+            printf("%-8s not supported\n", kernel->name);
+            continue;
+        }
+
+        int found = 0;
+        start = seconds_now();
+
+        for (int round = 0; round < rounds; round++)
+            found = content_scan(graph, kernel, pattern, NULL);
+
+        elapsed = seconds_now() - start;
+
+        printf("%-8s %d match(es) %8.3f GB/s%s\n", kernel->name, found, elapsed > 0 ? bytes / elapsed / 1e9 : 0.0,
+               kernel == substring_kernel_select() ? " (used)" : "");
+    }
+
+    return NULL;
+}
+
+// Function to print the (node, phrase) pairs of a match list as <id>:<line>, the line of the blocklist with the phrase
+static void print_matches(struct match_list *list, int from)
+{
+    for (int i = from; i < list->count; i++)
+        printf(i == from ? "%d:%d" : " %d:%d", list->matches[i].id, list->matches[i].number);
+
+    printf("\n");
+}
+
+// Function to run the blocklist command, loading the blocked phrases from a file
+static char *batch_blocklist(char *cursor)
+{
+    char *path = rest_field(&cursor);
+
+    if (path == NULL)
+        return "missing path";
+
+    FILE *input = fopen(path, "r");
+
+    if (input == NULL)
+        return "could not open the file";
+
+    int count = blocklist_load(input);
+
+    fclose(input);
+
+    return (count < 0) ? "could not load the blocklist" : NULL;
+}
+
+// Function to run the blocked command, printing every blocked phrase in every content
+static char *batch_blocked(char *cursor)
+{
+    (void)cursor; // Takes no fields
+
+    if (blocklist_search() < 0)
+        return "memory allocation failed";
+
+    print_matches(&found_matches, 0);
+
+    return NULL;
+}
+
+// Function to run the flagged command, printing the posts flagged since the program started
+static char *batch_flagged(char *cursor)
+{
+    (void)cursor; // Takes no fields
+
+    print_matches(&flagged_posts, 0);
+
+    return NULL;
+}
+
+// Function to run the posts command, printing a page of the posts of a node
+static char *batch_posts(char *cursor)
+{
+    int id, first = 0, count = 2147483647;
+    char *first_text, *count_text;
+
+    if (!int_field(next_field(&cursor), &id))
+        return "invalid id";
+
+    if ((first_text = next_field(&cursor)) != NULL && (!int_field(first_text, &first) || first < 0))
+        return "invalid first post";
+
+    if ((count_text = next_field(&cursor)) != NULL && (!int_field(count_text, &count) || count < 0))
+        return "invalid count";
+
+    if (print_posts(id, first, count) < 0)
+        return "no such node";
+
+    return NULL;
+}
+
+// Function to run the save command
+static char *batch_save(char *cursor)
+{
+    char *path = rest_field(&cursor);
+
+    if (path == NULL)
+        return "missing file";
+
+    if (!save_snapshot(path))
+        return "could not save the snapshot";
+
+    return NULL;
+}
+
+// Function to run a single command of the batch language
+char *run_command(char *line)
+{
+    char *cursor = line;
+    char *command = next_field(&cursor);
+
+    pagerank_poll(0);                       // Scores found in the background are handed out between commands
+
+    if (!strcmp(command, "create"))
+        return batch_create(cursor);
+    if (!strcmp(command, "link"))
+        return batch_link(cursor);
+    if (!strcmp(command, "post"))
+        return batch_post(cursor);
+    if (!strcmp(command, "search"))
+        return batch_search(cursor);
+    if (!strcmp(command, "one-hop"))
+        return batch_one_hop(cursor);
+    if (!strcmp(command, "two-hop"))
+        return batch_two_hop(cursor);
+    if (!strcmp(command, "k-hop"))
+        return batch_k_hop(cursor, 0);
+    if (!strcmp(command, "k-hop-count"))
+        return batch_k_hop(cursor, 1);
+    if (!strcmp(command, "threads"))
+        return batch_threads(cursor);
+    if (!strcmp(command, "path"))
+        return batch_path(cursor);
+    if (!strcmp(command, "connected"))
+        return batch_connected(cursor);
+    if (!strcmp(command, "components"))
+        return batch_components(cursor);
+    if (!strcmp(command, "pagerank"))
+        return batch_pagerank(cursor);
+    if (!strcmp(command, "pagerank-refresh"))
+        return batch_pagerank_refresh(cursor);
+    if (!strcmp(command, "top"))
+        return batch_top(cursor);
+    if (!strcmp(command, "score"))
+        return batch_score(cursor);
+    if (!strcmp(command, "delete"))
+        return batch_delete(cursor);
+    if (!strcmp(command, "load"))
+        return batch_load(cursor);
+    if (!strcmp(command, "save"))
+        return batch_save(cursor);
+    if (!strcmp(command, "delete-many"))
+        return batch_delete_many(cursor);
+    if (!strcmp(command, "compact"))
+        return batch_compact(cursor);
+    if (!strcmp(command, "content"))
+        return batch_content(cursor, 0);
+    if (!strcmp(command, "words"))
+        return batch_content(cursor, 1);
+    if (!strcmp(command, "bench"))
+        return batch_bench(cursor);
+    if (!strcmp(command, "blocklist"))
+        return batch_blocklist(cursor);
+    if (!strcmp(command, "blocked"))
+        return batch_blocked(cursor);
+    if (!strcmp(command, "flagged"))
+        return batch_flagged(cursor);
+    if (!strcmp(command, "posts"))
+        return batch_posts(cursor);
+    if (!strcmp(command, "post-at"))
+        return batch_post_at(cursor);
+    if (!strcmp(command, "feed"))
+        return batch_feed(cursor);
+    if (!strcmp(command, "near"))
+        return batch_near(cursor);
+    if (!strcmp(command, "within"))
+        return batch_within(cursor);
+    if (!strcmp(command, "box"))
+        return batch_box(cursor);
+    if (!strcmp(command, "birthday"))
+        return batch_birthday(cursor);
+    if (!strcmp(command, "birthday-any"))
+        return batch_birthday_any(cursor);
+    if (!strcmp(command, "upcoming"))
+        return batch_upcoming(cursor);
+
+    return "unknown command";
+}
+
+// Function to run all the commands in a file
+int run_batch(FILE *input)
+{
+    // Reading and writing in big blocks instead of a line at a time
+    setvbuf(input, NULL, _IOFBF, 1 << 16);
+
+    char *line = NULL;
+    size_t capacity = 0;
+
+    int line_number = 0;
+    int commands = 0;
+    int errors = 0;
+
+    while (read_line(input, &line, &capacity) != NULL)
     {
-        print_node(temp_grp, "Group");
+        line_number++;
 
-        if (flag)
+        if (line[0] == '\0' || line[0] == '#')                             // Empty lines and comments are skipped
+            continue;
+
+        commands++;
+
+        char *error = run_command(line);
+
+        if (error != NULL)
         {
-            printf("\n All the nodes present are:-\n\n");
-            flag = 0;
+            fprintf(stderr, "line %d: %s\n", line_number, error);
+            errors++;
         }
-        temp_grp = temp_grp->next;                           // Moving on to the next group
     }
 
-    if (flag)
+    free(line);
+
+    // A refresh still running in the background is waited for, so it's thread isn't left behind
+    pagerank_poll(1);
+
+    fflush(stdout);
+
+    fprintf(stderr, "%d command(s) run, %d error(s)\n", commands, errors);
+
+    return errors;
+}
+
+// Operation log
+
+// Function to write a string field to the log, with a backslash in front of the characters that would end it
+static void wal_escape(char *text)
+{
+    char *start = text;
+
+    for (; *text != '\0'; text++)
     {
-        printf("No nodes exist\n");                          // If no nodes exists currently in the system
+        if (*text != '\\' && *text != '|' && *text != '\n' && *text != '\r')
+            continue;
+
+        fwrite(start, 1, text - start, wal.file);
+        fputc('\\', wal.file);
+        fputc((*text == '\n') ? 'n' : (*text == '\r') ? 'r' : *text, wal.file);
+
+        start = text + 1;
     }
+
+    fwrite(start, 1, text - start, wal.file);
 }
 
-// Function to delete a node
-void delete_node()
+// Function to write a record to the log, flushing it to the disk once enough records have piled up
+void wal_record(char *format, ...)
 {
-    printf("Enter the ID of the node you want to delete:- ");
-    int id;
-    scanf("%d%c", &id, &throwaway);
-
-    int flag = 1;
+    if (wal.file == NULL || wal.paused)
+        return;
 
-    // Temporary iterators (pointers) to traverse the global lists
-    struct individual *temp_ind = all_Individuals;
-    struct business *temp_bus = all_business;
-    struct organisation *temp_org = all_Organisation;
-    struct group *temp_grp = all_Group;
+    va_list args;
+    va_start(args, format);
 
-    while (temp_ind != NULL && flag)  // Iterating over all the individuals to find a match
+    for (char *c = format; *c != '\0'; c++)
     {
-        if (temp_ind->id == id)
+        if (*c != '%')
         {
-            flag = 0;
-            break;
+            fputc(*c, wal.file);
+            continue;
         }
 
-        temp_ind = temp_ind->next;  // Moving to the next individual
-    }
-    while (temp_bus != NULL && flag)  // Iterating over all the businesses to find a match
-    {
-        if (temp_bus->id == id)
-        {
-            flag = 0;
-            break;
-        }
+        // Copying the conversion out, as everything but the strings is left to fprintf()
+        char conversion[16] = "%";
+        int length = 1;
 
-        temp_bus = temp_bus->next;  // Moving to the next individual
-    }
-    while (temp_org != NULL && flag)  // Iterating over all the organisations to find a match
-    {
-        if (temp_org->id == id)
-        {
-            flag = 0;
-            break;
-        }
+        while (c[1] != '\0' && strchr("sdg", c[1]) == NULL && length < 14)
+            conversion[length++] = *++c;
 
-        temp_org = temp_org->next;  // Moving to the next organisation
+        conversion[length] = *++c;
+
+        if (*c == 's')
+            wal_escape(va_arg(args, char *));
+        else if (*c == 'g')
+            fprintf(wal.file, conversion, va_arg(args, double));
+        else if (strstr(conversion, "ll") != NULL)
+            fprintf(wal.file, conversion, va_arg(args, long long));
+        else
+            fprintf(wal.file, conversion, va_arg(args, int));
     }
-    while (temp_grp != NULL && flag)  // Iterating over all the groups to find a match
-    {
-        if (temp_grp->id == id)
-        {
-            flag = 0;
-            break;
-        }
 
-        temp_grp = temp_grp->next;  // Moving to the next organisation
+    va_end(args);
+
+    fputc('\n', wal.file);
+
+    wal.pending++;
+
+    if (wal.sync_every > 0 && wal.pending >= wal.sync_every && wal.held == 0)
+        wal_sync();
+}
+
+// Function to make every record written so far durable
+int wal_sync()
+{
+    if (wal.file == NULL)
+        return 1;
+
+    wal.pending = 0;
+
+    // A single fsync covers all the records since the last one
+    return fflush(wal.file) == 0 && fsync(fileno(wal.file)) == 0;
+}
+
+// Function to empty the log, once the records in it are part of a snapshot
+int wal_reset()
+{
+    if (wal.file == NULL)
+        return 1;
+
+    fflush(wal.file);
+
+    if (ftruncate(fileno(wal.file), 0) != 0)
+        return 0;
+
+    fseek(wal.file, 0, SEEK_SET);
+
+    // The generation in the first line ties the log to the snapshot it continues from
+    fprintf(wal.file, "# log %lld\n", wal.generation);
+    wal.pending = 0;
+
+    return wal_sync();
+}
+
+// Function to replay the records of a log file, returns the number of records that failed or -1 if the log can't be used.
+// current is set if the log continues from the loaded snapshot, so that new records can be added to it
+static int wal_replay(FILE *input, int *current)
+{
+    char *line = NULL;
+    size_t capacity = 0;
+
+    int line_number = 0;
+    int records = 0;
+    int errors = 0;
+
+    long long generation = -1;
+
+    *current = 0;
+
+    if (read_line(input, &line, &capacity) != NULL && sscanf(line, "# log %lld", &generation) == 1)
+        line_number++;
+    else
+    {
+        // A log without the generation line is taken to continue from an empty network
+        generation = 0;
+        rewind(input);
     }
 
-    if (flag)
+    if (generation > wal.generation)
     {
-        printf("No such node exists\n");
+        free(line);
+        return -1; // The log continues from a newer snapshot than the one loaded
     }
-    else
+
+    // A log older than the snapshot only holds changes that are already part of it
+    if (generation < wal.generation)
     {
-        if (temp_ind != NULL) // Means that the node to be deleted is of the type individual
-        {
-            // Temporary iterators(pointers) to the back nodes so as to free the given individual
+        free(line);
+        return 0;
+    }
 
-            struct linked_business *bus = temp_ind->back_bus;
-            struct linked_organisation *org = temp_ind->back_org;
-            struct linked_group *grp = temp_ind->back_grp;
+    *current = (line_number == 1);
 
-            while (bus != NULL) // Iterating over all the business(es) in which the node is present
-            {   
-                if(bus->node_bus->owners != NULL){
-                    if (bus->node_bus->owners->node_ind->id == temp_ind->id) // If the head of the owner list is to be deleted
-                    {
-                        struct linked_individual* temp = bus->node_bus->owners; // A temporary pointer to the required node
-                        bus->node_bus->owners = bus->node_bus->owners->next;    // Assigning the next element as the new head of the list
-                        free(temp);                                             // Freeing the node, essentially removing the link between them
-                    }
-                    else
-                    {
-                        // Temporary iterators to iterate over
-                        struct linked_individual *curr = bus->node_bus->owners->next; // Points to the current owner node being examined
-                        struct linked_individual *prev = bus->node_bus->owners;       // Points to the recent node already examined to link
-
-                        while (curr != NULL)
-                        {
-                            if (curr->node_ind->id == temp_ind->id)                     // Checking for a match
-                            {
-                                prev->next = curr->next;                                // Linking the prev node with the next node
-                                free(curr);                                             // Free the link
-                                break;
-                            }
-
-                            prev = curr;
-                            curr = curr->next; // Traversing the list
-                        }
-                    }
-                }
+    wal.paused++;
+    wal.replaying++;
 
-                // Checking in the customer's list
-                if(bus->node_bus->customers != NULL){
-                    if (bus->node_bus->customers->node_ind->id == temp_ind->id )    // If the head of the customer list is to be deleted
-                    {
-                        struct linked_individual *temp = bus->node_bus->customers; // A temporary pointer to the required node
-                        bus->node_bus->customers = bus->node_bus->customers->next; // Assigning the next element as the new head of the list
-                        free(temp);
-                        printf("145\n");
-                    }
-                    else
-                    {
-                        // Temporary iterators to iterate over
-                        struct linked_individual *curr = bus->node_bus->customers->next; // Points to the current owner node being examined
-                        struct linked_individual *prev = bus->node_bus->customers;       // Points to the recnt node already examined to link
-
-                        while (curr != NULL)
-                        {
-                            if (curr->node_ind->id == temp_ind->id) // Checking for a match
-                            {
-                                prev->next = curr->next; // Linking the prev node with the next node
-                                free(curr);              // free the link
-                                break;
-                            }
-
-                            prev = curr;
-                            curr = curr->next; // Traversing the list
-                        }
-                    }
-                }
+    while (read_line(input, &line, &capacity) != NULL)
+    {
+        line_number++;
 
-                struct linked_business *free_the_bus = bus;
-                bus = bus->next;    // Moving to the next business in which the node is present
-                free(free_the_bus); // Freeing the back pointer to the current business
-            }
-            while (org != NULL) // Iterating over all the organisation(s) in which the node is present
-            {
-                // Deleting the link in the member's list
-                if(org->node_org->orgmember_head != NULL){
-                    if (org->node_org->orgmember_head->node_ind->id == temp_ind->id)
-                    {
-                        struct linked_individual *temp = org->node_org->orgmember_head;
-                        org->node_org->orgmember_head = org->node_org->orgmember_head->next;
-                        free(temp);
-                    }
-                    else
-                    {
-                        // Temporary iterators to iterate over
-                        struct linked_individual *curr = org->node_org->orgmember_head->next; // Points to the current member being examined
-                        struct linked_individual *prev = org->node_org->orgmember_head;       // Points to the recnt node already examined to link
-
-                        while (curr != NULL)
-                        {
-                            if (curr->node_ind->id == temp_ind->id) // Checking for a match
-                            {
-                                prev->next = curr->next; // Linking the prev node with the next node
-                                free(curr);              // free the link
-                                break;
-                            }
-
-                            prev = curr;
-                            curr = curr->next; // Traversing the list
-                        }
-                    }
-                }
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
 
-                struct linked_organisation *free_the_org = org;
-                org = org->next;    // Moving to the next organisation
-                free(free_the_org); // Freeing the back pointer to the current organisation
-            }
-            while (grp != NULL)
-            {
-                // Deleting the node link from the members list
-                if(grp->node_grp->grpmember_head != NULL){
-                    if (grp->node_grp->grpmember_head->node_ind->id == temp_ind->id) // If the head of the group list is to be deleted
-                    {
-                        struct linked_individual *temp = grp->node_grp->grpmember_head;
-                        grp->node_grp->grpmember_head = grp->node_grp->grpmember_head->next;
-                        free(temp);
-                    }
-                    else
-                    {
-                        // Temporary iterators to iterate over
-                        struct linked_individual *curr = grp->node_grp->grpmember_head->next; // Points to the current member being examined
-                        struct linked_individual *prev = grp->node_grp->grpmember_head;       // Points to the recnt node already examined to link
-
-                        while (curr != NULL)
-                        {
-                            if (curr->node_ind->id == temp_ind->id) // Checking for a match
-                            {
-                                prev->next = curr->next; // Linking the prev node with the next node
-                                free(curr);              // free the link
-                                break;
-                            }
-
-                            prev = curr;
-                            curr = curr->next; // Traversing the list
-                        }
-                    }
-                }
+        records++;
 
-                struct linked_group *free_the_grp = grp;
-                grp = grp->next;    // Moving to the next group
-                free(free_the_grp); // Freeing the back pointer to the current group
-            }
+        char *error = run_command(line);
 
-            // Now freeing the node and it's inner data
+        if (error != NULL)
+        {
+            fprintf(stderr, "log line %d: %s\n", line_number, error);
+            errors++;
+        }
+    }
 
-            struct individual *temp = all_Individuals;
+    wal.replaying--;
+    wal.paused--;
 
-            if (all_Individuals->id == temp_ind->id) // The node is the head of global linked list
-            {
-                all_Individuals = all_Individuals->next; // Changing the head of the list
-            }
-            else
-            {
+    free(line);
 
-                struct individual *prev = all_Individuals; // Tracks the previous node examined
-                while (temp != NULL)
-                {
-                    if (temp->id == temp_ind->id) // If the node is found
-                    {
-                        prev->next = temp->next; // Linking the previous and next node
-                        break;
-                    }
+    fprintf(stderr, "%d logged change(s) replayed, %d error(s)\n", records, errors);
 
-                    prev = temp;       // Current node becomes prev
-                    temp = temp->next; // Iterating through the list
-                }
-            }
+    return errors;
+}
 
-            // Freeing each attribute
-            free(temp->name);
-            free(temp->creation);
-            free(temp->content);
-            free(temp->birthday);
+// Function to drop a record that was cut off half way by a crash, returns 0 if the file couldn't be fixed
+static int wal_trim(int descriptor)
+{
+    struct stat file_info;
 
-            // Finally deleting the node
-            free(temp_ind);
+    if (fstat(descriptor, &file_info) < 0)
+        return 0;
 
-            printf("\n******** Successfully deleted ********\n");
-        }
-        else if (temp_bus != NULL) // The node to be deleted is of the type business
-        {
-            // Temporary iterator(pointer) to iterate over the back grp list
+    off_t size = file_info.st_size;
+    char last;
 
-            struct linked_group *grp = temp_bus->back_grp;
+    // Every complete record ends with a new line, so the log is cut back to the last one
+    while (size > 0 && pread(descriptor, &last, 1, size - 1) == 1 && last != '\n')
+        size--;
 
-            while (grp != NULL)
-            {   
-                if(grp->node_grp->businessmember_head != NULL){
-                    if (grp->node_grp->businessmember_head->node_bus->id == temp_bus->id)
-                    {
-                        struct linked_business *temp = grp->node_grp->businessmember_head;             // Temporary pointer to the head
-                        grp->node_grp->businessmember_head = grp->node_grp->businessmember_head->next; // Next element becomes the new head of the business member head
-                        free(temp);                                                                    // Freeing the node
-                    }
-                    else
-                    {
-                        // Temporary iterators to iterate over
-                        struct linked_business *curr = grp->node_grp->businessmember_head->next; // Points to the current owner being examined
-                        struct linked_business *prev = grp->node_grp->businessmember_head;       // Points to the recent node already examined
-
-                        while (curr != NULL)
-                        {
-                            if (curr->node_bus->id == temp_bus->id)
-                            {
-                                prev->next = curr->next; // Linking the previous node with the next node
-                                free(curr);              // Free the link
-                                break;
-                            }
-
-                            prev = curr;
-                            curr = curr->next;
-                        }
-                    }
-                }
+    if (size == file_info.st_size)
+        return 1;
 
-                struct linked_group *free_the_grp = grp;
-                grp = grp->next;    // Moving to the next group
-                free(free_the_grp); // Freeing the back pointer link
-            }
+    return ftruncate(descriptor, size) == 0;
+}
 
-            // Freeing each attribute
+// Function to replay a log and keep appending to it
+int wal_open(char *path, int sync_every)
+{
+    if (wal.file != NULL)
+        return 0;
 
-            free(temp_bus->name);
-            free(temp_bus->creation);
-            free(temp_bus->content);
+    int descriptor = open(path, O_RDWR | O_CREAT, 0644);
 
-            // Freeing the links in customer and owner lists
+    if (descriptor < 0)
+        return 0;
 
-            struct linked_individual *member_curr = temp_bus->owners; // Pointer to the head of the owner list
-            struct linked_individual *member_prev;                    // Points to the previous node link so as to be freed
+    // Records are only ever added at the end
+    FILE *file = fdopen(descriptor, "a+");
 
-            while (member_curr != NULL)
-            {
-                member_prev = member_curr;
-                member_curr = member_curr->next; // Moving on to the next link
-                free(member_prev);               // Freeing the iterated node link
-            }
+    if (file == NULL)
+    {
+        close(descriptor);
+        return 0;
+    }
 
-            // Now freeing the customers list
-            member_curr = temp_bus->customers;
+    setvbuf(file, NULL, _IOFBF, 1 << 16);
 
-            while (member_curr != NULL)
-            {
-                member_prev = member_curr;
-                member_curr = member_curr->next; // Moving on to the next link
-                free(member_prev);               // Freeing the iterated node link
-            }
+    int current;
 
-            // Freeing the node from the global list
-            struct business *temp = all_business;
+    if (!wal_trim(descriptor) || wal_replay(file, &current) < 0)
+    {
+        fclose(file);
+        return 0;
+    }
 
-            if (all_business->id == temp_bus->id) // The node is the head of the global list
-            {
-                all_business = all_business->next; // Changing the head of the list
-            }
-            else
-            {
-                struct business *prev = all_business;
-                while (temp != NULL)
-                {
-                    if (temp->id == temp_bus->id) // If the node is found
-                    {
-                        prev->next = temp->next; // Linking the previous and next node
-                        break;
-                    }
+    wal.file = file;
+    wal.sync_every = sync_every;
+    wal.pending = 0;
 
-                    prev = temp;       // Current node becomes prev
-                    temp = temp->next; // Iterating through the list
-                }
-            }
+    fseek(file, 0, SEEK_END);
 
-            // Finally freeing the node
-            free(temp_bus);
+    // Starting the log afresh if it is empty or belongs to an older snapshot
+    if (!current && !wal_reset())
+    {
+        wal_close();
+        return 0;
+    }
 
-            printf("\n******** Successfully deleted ********\n");
-        }
-        else if (temp_org != NULL) // The node to be deleted is of organisation type
-        {
-            // Freeing the members in the organisation
+    atexit(wal_close); // So that the records still in the buffer aren't lost on a normal exit
 
-            struct linked_individual *curr = temp_org->orgmember_head;
-            struct linked_individual *prev;
+    return 1;
+}
 
-            while (curr != NULL)
-            {
-                prev = curr;
-                curr = curr->next;
-                free(prev);
-            }
+// Function to flush and close the log
+void wal_close()
+{
+    if (wal.file == NULL)
+        return;
 
-            // Deleting the node from the global list
-            struct organisation *temp = all_Organisation;
+    wal_sync();
+    fclose(wal.file);
 
-            if (all_Organisation->id == temp_org->id)
-            {
-                all_Organisation = all_Organisation->next;
-            }
-            else
-            {
-                struct organisation *prev = all_Organisation;
-                while (temp != NULL)
-                {
-                    if (temp->id == temp_org->id)
-                    {
-                        prev->next = temp->next;
-                        break;
-                    }
+    wal.file = NULL;
+}
 
-                    prev = temp;
-                    temp = temp->next;
-                }
-            }
+int main(int argc, char *argv[]) {
+    int sync_every = 1;
 
-            // Freeing the attributes of the node
-            free(temp_org->name);
-            free(temp_org->creation);
-            free(temp_org->content);
+    // Number of threads the traversals run on
+    if (argc > 2 && !strcmp(argv[1], "--threads"))
+    {
+        if (!thread_pool_start(atoi(argv[2])))
+        {
+            printf("Could not start %s threads\n", argv[2]);
+            return 1;
+        }
 
-            // Finally deleting the node
-            free(temp_org);
+        argc -= 2;
+        argv += 2;
+    }
 
-            printf("\n******** Successfully deleted ********\n");
-        }
-        else if (temp_grp != NULL) // The node to be deleted is a group
-        {
-            // Freeing the individual member links
+    // Phrases every new post is checked against
+    if (argc > 2 && !strcmp(argv[1], "--blocklist"))
+    {
+        FILE *input = fopen(argv[2], "r");
 
-            struct linked_individual *curr = temp_grp->grpmember_head;
-            struct linked_individual *prev;
+        if (input == NULL || blocklist_load(input) < 0)
+        {
+            printf("Could not load the blocklist %s\n", argv[2]);
+            return 1;
+        }
 
-            while (curr != NULL)
-            {
-                prev = curr;
-                curr = curr->next;
-                free(prev);
-            }
+        fclose(input);
 
-            // Freeing the business member links
+        argc -= 2;
+        argv += 2;
+    }
 
-            struct linked_business *curr_bus = temp_grp->businessmember_head;
-            struct linked_business *prev_bus;
+    // Starting from a saved snapshot instead of an empty network
+    if (argc > 2 && !strcmp(argv[1], "--snapshot"))
+    {
+        if (!load_snapshot(argv[2]))
+        {
+            printf("Could not load the snapshot %s\n", argv[2]);
+            return 1;
+        }
 
-            while (curr_bus != NULL)
-            {
-                prev_bus = curr_bus;
-                curr_bus = curr_bus->next;
-                free(prev_bus);
-            }
+        argc -= 2;
+        argv += 2;
+    }
 
-            // Removing the node from the global list
-            struct group *temp = all_Group;
+    // Number of changes written to the log per fsync, 0 leaves the syncing to the system
+    if (argc > 2 && !strcmp(argv[1], "--sync-every"))
+    {
+        sync_every = atoi(argv[2]);
 
-            if (all_Group->id == temp_grp->id)
-            {
-                all_Group = all_Group->next;
-            }
-            else
-            {
-                struct group *prev = all_Group;
-                while (temp != NULL)
-                {
-                    if (temp->id == temp_grp->id)
-                    {
-                        prev->next = temp->next;
-                        break;
-                    }
+        argc -= 2;
+        argv += 2;
+    }
 
-                    prev = temp;
-                    temp = temp->next;
-                }
-            }
+    // Replaying the changes made since the snapshot, and logging every change from now on
+    if (argc > 2 && !strcmp(argv[1], "--log"))
+    {
+        if (!wal_open(argv[2], sync_every))
+        {
+            printf("Could not open the log %s\n", argv[2]);
+            return 1;
+        }
 
-            // Freeing the attributes of the node
-            free(temp_grp->name);
-            free(temp_grp->creation);
-            free(temp_grp->content);
+        argc -= 2;
+        argv += 2;
+    }
 
-            // Finally deleting the node
-            free(temp_grp);
+    // Running the commands in the given file (or stdin for "-") without the menu
+    if (argc > 1)
+    {
+        FILE *input = strcmp(argv[1], "-") ? fopen(argv[1], "r") : stdin;
 
-            printf("\n******** Successfully deleted ********\n");
+        if (input == NULL)
+        {
+            printf("Could not open %s\n", argv[1]);
+            return 1;
         }
+
+        setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+
+        return run_batch(input) ? 1 : 0;
     }
-}
 
-int main() {
     while (1) {
         // Display menu options
         printf("\n******** Enter your choice ********\n\n"
@@ -2154,6 +8265,15 @@ int main() {
                "6 ==> Search for content\n"
                "7 ==> Print two-hop individual nodes\n"
                "8 ==> Delete a node\n"
+               "9 ==> Search for words or \"phrases\"\n"
+               "10 ==> Check all contents against a blocklist\n"
+               "11 ==> Print the feed of a node\n"
+               "12 ==> Print the nearest nodes to a node\n"
+               "13 ==> Print the upcoming birthdays\n"
+               "14 ==> Count the nodes within k hops\n"
+               "15 ==> Print the shortest path between two nodes\n"
+               "16 ==> Print the connected components\n"
+               "17 ==> Print the most influential nodes\n"
                "-1 ==> Exit\n\n");
 
         int input;
@@ -2175,26 +8295,8 @@ int main() {
                 scanf("%d%c", &input, &throwaway);
 
                 if (input >= 1 && input <= 4) {
-                    // Valid type input
-                    char nodeType[20];
-
-                    // Map user input to node type
-                    switch (input) {
-                        case 1:
-                            strcpy(nodeType, "Individual");
-                            break;
-                        case 2:
-                            strcpy(nodeType, "Business");
-                            break;
-                        case 3:
-                            strcpy(nodeType, "Organisation");
-                            break;
-                        case 4:
-                            strcpy(nodeType, "Group");
-                            break;
-                    }
-
-                    new_node(nodeType);
+                    // Valid type input, the menu follows the order of enum node_kind
+                    new_node((enum node_kind)(input - 1));
                 } else {
                     printf("\nInvalid input. Please enter a number between 1 and 4.\n");
                 }
@@ -2266,7 +8368,15 @@ int main() {
                 // Print two-hop individual nodes
                 printf("\nEnter the ID of the Individual node\n");
                 scanf("%d%c", &id, &throwaway);
-                two_hop((struct individual *)search_by_id(id));
+
+                struct id_slot *slot = id_index_find(id);
+
+                if (slot == NULL)
+                    printf("No such node exists\n");
+                else if (slot->kind != NODE_INDIVIDUAL)
+                    printf("The node with ID %d is not an Individual\n", id);
+                else
+                    two_hop((struct individual *)slot->node);
                 break;
 
             case 8:
@@ -2274,9 +8384,110 @@ int main() {
                 delete_node();
                 break;
 
+            case 9:
+                // Search for words and phrases
+                printf("\nEnter the words you want to search\n");
+                char *query = content_input();
+                search_for_words(query);
+                break;
+
+            case 10:
+                // Check all contents against a blocklist
+                printf("\nEnter the path of the blocklist, one phrase per line\n");
+                char *path = content_input();
+                check_blocklist(path);
+                free(path);
+                break;
+
+            case 11:
+                // Print the latest posts of the 1-hop nodes
+                printf("\nEnter the ID of the node\n");
+                scanf("%d%c", &id, &throwaway);
+                printf("\nEnter the number of posts\n");
+                int count;
+                scanf("%d%c", &count, &throwaway);
+                print_feed(id, count);
+                break;
+
+            case 12:
+                // Print the nearest businesses, organisations or groups
+                printf("\nEnter the ID of the node\n");
+                scanf("%d%c", &id, &throwaway);
+                printf("\nEnter the type of the nodes you want, or any\n");
+                char *near_type = name_input();
+                printf("\nEnter the number of nodes\n");
+                scanf("%d%c", &count, &throwaway);
+
+                int near_kind = strcmp(near_type, "any") ? kind_from_type(near_type) : -1;
+
+                if (near_kind == NODE_INDIVIDUAL || (near_kind == -1 && strcmp(near_type, "any")))
+                    printf("Only Business, Organisation, Group or any can be searched\n");
+                else
+                    print_places_near(id, near_kind, count);
+
+                free(near_type);
+                break;
+
+            case 13:
+                // Print the individuals having their birthday in the next days
+                printf("\nEnter the date to start from\n");
+                struct tm *from = date_input();
+                printf("\nEnter the number of days\n");
+                int days;
+                scanf("%d%c", &days, &throwaway);
+
+                if (from != NULL)
+                    print_upcoming_birthdays(from, days);
+
+                free(from);
+                break;
+
+            case 14:
+                // Count the nodes within a number of hops
+                printf("\nEnter the ID of the node\n");
+                scanf("%d%c", &id, &throwaway);
+                printf("\nEnter the number of hops\n");
+                int hops;
+                scanf("%d%c", &hops, &throwaway);
+                print_k_hop(id, hops);
+                break;
+
+            case 15:
+                // Print how two nodes are connected
+                printf("\nEnter the ID of the first node\n");
+                scanf("%d%c", &id, &throwaway);
+                printf("\nEnter the ID of the second node\n");
+                int other_id;
+                scanf("%d%c", &other_id, &throwaway);
+                print_shortest_path(id, other_id);
+                break;
+
+            case 16:
+                // Print the clusters of nodes not linked to each other
+                print_components();
+                break;
+
+            case 17:
+                // Print the nodes with the highest PageRank scores
+                printf("\nEnter the type of the nodes you want, or any\n");
+                char *top_type = name_input();
+                printf("\nEnter the number of nodes\n");
+                scanf("%d%c", &count, &throwaway);
+
+                int top_kind = strcmp(top_type, "any") ? kind_from_type(top_type) : -1;
+
+                if (top_kind == -1 && strcmp(top_type, "any"))
+                    printf("Only Individual, Business, Organisation, Group or any can be searched\n");
+                else
+                    print_top_scores(top_kind, count);
+
+                free(top_type);
+                break;
+
             case -1:
                 // Exit the program
                 printf("\nExiting the program.\n");
+                pagerank_poll(1);
                 return 0;
 
             default:
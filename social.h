@@ -18,10 +18,15 @@
  *
  * Functions:
  * -----------
+ * - pool_alloc(), pool_free(), pool_reserve(): Slab allocation of the nodes and the linked_* cells.
+ * - csr_mark_stale(), csr_snapshot(): Maintain the CSR snapshot of the graph used by the traversals.
+ * - id_index_reserve(), id_index_insert(), id_index_find(), id_index_remove(): Maintain the global index from ID to node.
+ * - name_index_reserve(), name_index_insert(), name_index_find(), name_index_next(), name_index_remove(): Maintain the per kind index from name to node(s).
  * - name_input(): Takes user input for the name string.
  * - date_input(): Takes user input for a date structure.
  * - content_input(): Takes user input for the content string.
  * - birthday_input(): Takes user input for a birthday structure.
+ * - kind_from_type(): Maps a type string to the kind of a node.
  * - print_node(): Prints the attributes of a given node.
  * - search(): Searches and prints nodes based on a given parameter.
  * - search_by_id(): Searches and returns a node based on its ID.
@@ -30,12 +35,40 @@
  * - search_to_link(): Searches for a node with matching parameters and links it.
  * - new_node(): Creates a new node of all types.
  * - one_hop(): Prints one-hop nodes for a node with a given ID.
- * - swap_nodes(): Swaps content between two nodes.
  * - two_hop(): Prints two-hop nodes for a given individual node.
+ * - k_hop_collect(), print_k_hop(): Find the nodes within k hops of a node with a direction-optimizing BFS.
+ * - thread_pool_start(), thread_pool_stop(): Set the number of threads the k-hop levels are expanded by.
+ * - shortest_path(), print_shortest_path(): Find how two nodes are connected with a bidirectional BFS.
+ * - components_add_node(), components_add_link(), components_mark_dirty(): Keep the connected components up to date.
+ * - components_rebuild(), nodes_connected(), components_collect(), print_components(): Find the connected components.
+ * - pagerank_compute(), pagerank_refresh(), pagerank_poll(): Score the influence of the nodes with PageRank.
+ * - top_scores(), print_top_scores(): Find the most influential nodes.
  * - add_content(): Adds content to a node.
  * - search_for_content(): Searches and prints nodes with content containing a given string.
+ * - post_log_append(), post_log_drop_last(), post_log_map(), post_log_free(), post_log_seek(), post_log_next(): Store the posts of a node in chunks.
+ * - print_whole_content(), print_posts(): Print the content and posts of a node, all of them or a page at a time.
+ * - post_log_seek_end(), post_log_prev(), post_content_at(): Read the posts from the latest, and post at a given time.
+ * - feed_collect(), print_feed(): The latest posts of the one-hop nodes of a node, merged by time.
+ * - spatial_index_insert(), spatial_index_remove(): Maintain the k-d trees over the coordinates of the nodes.
+ * - places_within(), places_in_box(), places_nearest(), print_places_near(): Find the nodes near a point or inside a box.
+ * - birthday_index_insert(), birthday_index_remove(): Maintain the index of the individuals by their birthday.
+ * - birthdays_on(), birthdays_on_day(), upcoming_birthdays(), print_upcoming_birthdays(): Find the birthdays on a date, a day of any year or in the next days.
+ * - search_for_words(), content_search(): Search the contents for words and phrases through the word index.
+ * - next_word(), word_index_add(), word_index_remove(): Maintain the inverted index from a word to the nodes using it.
+ * - trigram_index_add(), trigram_index_remove(): Maintain the same index for the trigrams of the contents.
+ * - content_arena_build(), content_arena_mark_stale(), substring_kernel_select(): Scan all the contents at once with SIMD.
+ * - pattern_set_compile(), pattern_set_clear(): Compile many patterns into a single Aho-Corasick automaton.
+ * - blocklist_load(), blocklist_search(), blocklist_check(), check_blocklist(): Find blocked phrases in contents and new posts.
  * - print_all(): Prints all nodes in the system.
  * - delete_node(): Deletes a node from the system.
+ * - create_node(), link_member(), post_content(), remove_node(): The same operations without any input from the user.
+ * - remove_nodes(), compact_memory(), pool_compact(): Delete many nodes at once and pack the memory left behind.
+ * - run_command(), run_batch(): Run commands of the batch language, from a file or stdin.
+ * - load_nodes(), load_edges(): Bulk load the nodes and links from CSV and edge list files.
+ * - save_snapshot(), load_snapshot(): Save the whole network to a binary snapshot and map it back in.
+ * - index_require(): Build the indexes a loaded snapshot left out, the first time they are used.
+ * - in_snapshot(), release_memory(): Tell apart and free the attributes that aren't part of a mapped snapshot.
+ * - wal_open(), wal_record(), wal_sync(), wal_reset(), wal_close(): Log every change made since the last snapshot.
  *
  * @note All structures and function prototypes are defined in this header file.
  */
@@ -46,16 +79,59 @@
 // Used headers
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+
+// The SIMD substring kernels are built for x86 with GCC or Clang, which can pick them at runtime
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SUBSTRING_SIMD
+#include <immintrin.h>
+#endif
 
 // Forward Declarations
+struct post_log;
 struct linked_individual;
 struct linked_business;
 struct linked_organisation;
 struct linked_group;
 
+/**
+ * @enum node_kind
+ * @brief The four types a node in the system can be of
+ *
+ * Stored as a single byte at the very start of every node, so that the type of any node can be read through a void pointer.
+ */
+enum node_kind
+{
+    NODE_INDIVIDUAL,
+    NODE_BUSINESS,
+    NODE_ORGANISATION,
+    NODE_GROUP
+};
+
+/**
+ * @enum link_role
+ * @brief The role in which a member is linked to a business, organisation or group
+ *
+ * Individuals are linked to businesses as owners or customers, every other link is a plain membership.
+ */
+enum link_role
+{
+    LINK_MEMBER,
+    LINK_OWNER,
+    LINK_CUSTOMER
+};
+
+// Reads the kind of a node through a void pointer, as the kind is the first member of every node
+#define NODE_KIND(node) ((enum node_kind)(*(unsigned char *)(node)))
 
 /**
  * @struct date
@@ -77,12 +153,12 @@ struct date
  * 
  * 
  * Contains back pointers of heads of lists to group,organisations and business along with it's own attributes, with a unique birthday attribute.
- * Also has a next pointer of the same type to be linked in a global list and a type string to know it's type
+ * Also has a next pointer of the same type to be linked in a global list and a kind tag to know it's type
 */
 struct individual
 {
 
-    char type[20];
+    unsigned char kind; // enum node_kind of the node, has to stay the first member
 
     // Back pointers
 
@@ -95,20 +171,28 @@ struct individual
     int id;
     char *name;
     struct tm *creation;
-    char *content;
+    char *content;          // Content given when the node was created
+    struct post_log *posts; // Everything posted since, NULL till the first post
 
     // Unique Attribute(s)
 
     struct tm *birthday;
 
+    int csr_index; // Dense index of the node in the CSR snapshot of the graph
+    int component; // Element of the node in the union-find of the connected components
+    double score;  // Influence of the node, see pagerank_compute()
+
     struct individual *next;
+    struct individual **pprev; // Address of the pointer to this node in the global list
 };
 
 /**
  * @struct linked_individual
  * @brief Structure that stores a pointer to a indvidual node
  * 
- * It acts as a container to an individual node, thereby used in linking and preventing duplication
+ * It acts as a container to an individual node, thereby used in linking and preventing duplication.
+ * Every link is made of two cells, one in the list of each node, pointing to each other through twin.
+ * Along with pprev this lets either end remove the whole link without walking the other node's list.
 */
 struct linked_individual
 {
@@ -116,6 +200,8 @@ struct linked_individual
     struct individual *node_ind; // The individual to which it points
 
     struct linked_individual *next;
+    struct linked_individual **pprev; // Address of the pointer to this cell, so that it can unlink itself
+    void *twin; // The cell of the same link in the list of the other node
 };
 
 /**
@@ -124,12 +210,12 @@ struct linked_individual
  * 
  * Containes back pinter to the head of a list of groups in which the business is present as a member, along with it it's own attributes.
  * Some unique attrbiutes are the Co-ordinates of the business, along with the heads of list of customers and owners.
- * Has a next pointer to be linked to differnet business nodes and a type string to know it's type
+ * Has a next pointer to be linked to differnet business nodes and a kind tag to know it's type
 */
 struct business
 {
 
-    char type[20];
+    unsigned char kind; // enum node_kind of the node, has to stay the first member
 
     // Back pointers
 
@@ -140,7 +226,8 @@ struct business
     int id;
     char *name;
     struct tm *creation;
-    char *content;
+    char *content;          // Content given when the node was created
+    struct post_log *posts; // Everything posted since, NULL till the first post
 
     // Unique Attribute(s)
 
@@ -149,7 +236,12 @@ struct business
     struct linked_individual *owners;
     struct linked_individual *customers;
 
+    int csr_index; // Dense index of the node in the CSR snapshot of the graph
+    int component; // Element of the node in the union-find of the connected components
+    double score;  // Influence of the node, see pagerank_compute()
+
     struct business *next;
+    struct business **pprev; // Address of the pointer to this node in the global list
 };
 
 /**
@@ -164,6 +256,8 @@ struct linked_business
     struct business *node_bus;
 
     struct linked_business *next;
+    struct linked_business **pprev; // Address of the pointer to this cell, so that it can unlink itself
+    void *twin; // The cell of the same link in the list of the other node
 };
 
 /**
@@ -172,19 +266,20 @@ struct linked_business
  * 
  * Doesn't have nay back pointers as they are not required. contains the basic attributes, along with Co-ordinates,
  * and the had pointer to a list of Indvidual type members it ahs, stored through the linked_individual type. 
- * Also has a next pointer used to link it with other organisations and a type string to know it's type
+ * Also has a next pointer used to link it with other organisations and a kind tag to know it's type
 */
 struct organisation
 {
 
-    char type[20];
+    unsigned char kind; // enum node_kind of the node, has to stay the first member
 
     // Basic Attributes
 
     int id;
     char *name;
     struct tm *creation;
-    char *content;
+    char *content;          // Content given when the node was created
+    struct post_log *posts; // Everything posted since, NULL till the first post
 
     // Unique Attribute(s)
 
@@ -192,7 +287,12 @@ struct organisation
     double y_cord;
     struct linked_individual *orgmember_head;
 
+    int csr_index; // Dense index of the node in the CSR snapshot of the graph
+    int component; // Element of the node in the union-find of the connected components
+    double score;  // Influence of the node, see pagerank_compute()
+
     struct organisation *next;
+    struct organisation **pprev; // Address of the pointer to this node in the global list
 };
 
 /**
@@ -207,6 +307,8 @@ struct linked_organisation
     struct organisation *node_org;
 
     struct linked_organisation *next;
+    struct linked_organisation **pprev; // Address of the pointer to this cell, so that it can unlink itself
+    void *twin; // The cell of the same link in the list of the other node
 };
 
 /**
@@ -214,19 +316,20 @@ struct linked_organisation
  * @brief Structure that containes the required attributes of a group type node.
  * 
  * Has the basic attributes along with Co-ordinates and two lists of members, one of the type individual and the other 
- * of business. ALso has a next pointer to link with other groups and a type string to know it's type.
+ * of business. ALso has a next pointer to link with other groups and a kind tag to know it's type.
 */
 struct group
 {
 
-    char type[20];
+    unsigned char kind; // enum node_kind of the node, has to stay the first member
 
     // Basic Attributes
 
     int id;
     char *name;
     struct tm *creation;
-    char *content;
+    char *content;          // Content given when the node was created
+    struct post_log *posts; // Everything posted since, NULL till the first post
 
     // Unique Attribute(s)
 
@@ -235,7 +338,12 @@ struct group
     struct linked_individual *grpmember_head;
     struct linked_business *businessmember_head;
 
+    int csr_index; // Dense index of the node in the CSR snapshot of the graph
+    int component; // Element of the node in the union-find of the connected components
+    double score;  // Influence of the node, see pagerank_compute()
+
     struct group *next;
+    struct group **pprev; // Address of the pointer to this node in the global list
 };
 
 /**
@@ -250,272 +358,2230 @@ struct linked_group
     struct group *node_grp;
 
     struct linked_group *next;
+    struct linked_group **pprev; // Address of the pointer to this cell, so that it can unlink itself
+    void *twin; // The cell of the same link in the list of the other node
 };
 
 /**
- * @struct individual_hop
- * @brief Structure that contains the pinter to a container of a individual node
- * 
- * Used exclusivley to print out the two hop ndoes by storing the addresses of various containers it's linked with.
- * hAs a pointer of type linked_individual i.e the container and a next pointer to link.
+ * @struct id_slot
+ * @brief A single slot of the global ID index
+ *
+ * Stores the id of a node along with a tagged pointer to it, i.e the node and the kind it has to be typecasted to.
+ * The state tells if the slot is empty, in use or was used by a node that has since been deleted.
 */
-struct individual_hop
+struct id_slot
 {
-    struct linked_individual *lnkd_ind_node;
-    struct individual_hop *next;
+    int id;
+    unsigned char state; // SLOT_EMPTY, SLOT_USED or SLOT_DELETED
+    unsigned char kind;  // enum node_kind of the node
+
+    void *node;
 };
 
-/*
- * Takes input from the user character by character so that spaces are included too.
- * -----------
- * 
- * Parameters : None
- * -----------
- * 
- * Returns : A char pointer(array) with the name string
- * -----------
- * 
- * The string ends when a new line character is detected
- */
-char *name_input();
+/**
+ * @struct id_index
+ * @brief Open addressing hash table from the id of a node to the node itself
+ *
+ * The capacity is always a power of two so that the probe sequence can be computed with a mask.
+ * Deleted slots are kept as tombstones till the table is grown or rebuilt.
+*/
+struct id_index
+{
+    struct id_slot *slots;
+    int capacity;
+    int used;       // Slots holding a node
+    int tombstones; // Slots left behind by deleted nodes
+};
 
-/*
- * Function to take input of date from the user
- * -----------
- * 
- * Parameters : None
- * -----------
- * 
- * Returns : A struct tm type pointer of a structure containing the date
- * -----------
+/**
+ * @struct name_entry
+ * @brief A single entry of a name index
  *
- * If the date entered is wrong, -1 is returned for the day,month and year
- */
-struct tm *date_input();
+ * Stores the hash of the name along with the name and node it belongs to. Entries with the same bucket are chained
+ * through the next pointer, so nodes with the same name simply end up as different entries of the same chain.
+*/
+struct name_entry
+{
+    unsigned int hash;
+    char *name; // Points to the name attribute of the node, not a copy
+    void *node;
 
-/*
- * Takes input for the "Content" attribute of a node
- * -----------
- * 
- * Parameters : None
- * -----------
- * 
- * Returns : A char type pointer(array) of the content string
- * -----------
- * 
- * Works similar to the name_input function
- */
-char *content_input();
+    struct name_entry *next;
+};
 
-/*
- * Function to take input of birthday from the user
- * -----------
- * 
- * Parameters : None
- * -----------
- * 
- * Returns : A struct tm type pointer of a structure containing the birthday
- * -----------
- * 
- * Uses the name-input function if the user want's to input a birthday, otherwise a known invalid date is given
- */
-struct tm *birthday_input();
+/**
+ * @struct name_index
+ * @brief Chained hash table (multimap) from the name of a node to the node(s) with that name
+ *
+ * There is one such index for each kind of node. The number of buckets is a power of two and grows with the entries.
+*/
+struct name_index
+{
+    struct name_entry **buckets;
+    int capacity;
+    int count;
+};
 
-/*
- * Function to print a given node
- * -----------
- * 
- * Parameters :
- *          1) A node pointer of the type Void so that it can be typecasted to the required type
- *          2) A string type, to know which type of node has been given
- * -----------
- * 
- * Returns :
- *          Prints out the content of the node
- * -----------
- * 
- * Searches the global linked list for a match with the node, and Prints it's attributes
- */
-void print_node(void *node, char type[]);
+// Longest word kept by the word index, longer words are cut to this length
+#define WORD_LIMIT 64
 
-/*
- * Function to search for a given node and print it
- * -----------
- * 
- * Parameters :
- *          A string search_parameter, i.e the parameter the user wants to search for
- * -----------
- * 
- * Returns :
- *          Prints out the content of the node if it's required parameter matches with the given search_parameter
- * -----------
- * 
- * Used to print nodes if the user gives name or type as the search parameter.
- * Iterates over all the nodes and prints any nodes that match 𝘪𝘯 𝘴𝘪𝘵𝘶
- */
-void search(char search_parameter[]);
+/**
+ * @struct word_entry
+ * @brief A word in the word index along with it's posting list
+ *
+ * The posting list holds the ids of the nodes using the word in their content, sorted so that the lists of two words
+ * can be intersected by binary search. Entries with the same bucket are chained through the next pointer.
+*/
+struct word_entry
+{
+    unsigned int hash;
+    char *word;             // Lowercased copy of the word, or the three characters of a trigram as they are
 
-/*
- * Function to search for a given node and print it
- * -----------
- * 
- * Parameters :
- *          An integer id, which is unique to each node
- * -----------
- * 
- * Returns :
- *          returns a pointer of the the type void*, i.e it can be typecasted later
- * -----------
- * 
- * Runs over the global linked lists to find a macth between the given id and the id present in the node
- */
-void *search_by_id(int id);
+    int *ids;
+    int count;
+    int capacity;
 
-/*
- * Function that searches for a given birthday
- * -----------
- * 
- * Parameters :
- *          A struct tm (time) search_date, that contains the date to be searched
- * -----------
- * 
- * Returns :
- *          Prints out all the (individual) nodes with the given birthday
- * -----------
- * 
- * Since individuals are the only ones with a birthday iterates over the
- * global individual list and searches for a match
+    struct word_entry *next;
+};
+
+/**
+ * @struct word_index
+ * @brief Chained hash table (inverted index) from a word to the nodes using it
  *
- */
-void search_by_birthday(struct tm *search_date);
+ * A word is a run of letters and digits, compared without case. Kept up to date by create_node(), post_content() and
+ * remove_node(), so a content search only has to look at the nodes using the words it asks for.
+ *
+ * The same table also indexes the trigrams of the contents (every three consecutive characters, with their case), which
+ * lets a search for any substring of atleast three characters skip the nodes missing one of it's trigrams.
+*/
+struct word_index
+{
+    struct word_entry **buckets;
+    int capacity;
+    int count;
+};
 
-/*
- * Function to print the content of a node with a given id
- * -----------
- * 
- * Parameters :
- *          A integer id, which is unique for each node
- * -----------
- * 
- * Returns ;
- *          Prints out the content (attributes) in an orderly fashion
- * -----------
- * 
- * AS the id is unique for each node, we can just iterate over the global
- * lists and search for a match with the id. No match is taken care of.
- */
-void print_content(int id);
+/**
+ * @struct post_chunk
+ * @brief A block of posts stored one after the other, each ending with it's '\0'
+ *
+ * The data usually follows the chunk in the same allocation. For posts loaded from a snapshot it points into the
+ * mapping instead, along with the times, and the chunk is full so nothing is ever written to it.
+*/
+struct post_chunk
+{
+    struct post_chunk *next;
+    struct post_chunk *prev;
 
-/*
- * Funtion that returns nodes with the matching search_parameeter and type,
- * which are then linked in
- * -----------
- * 
- * Parameters :
- *          1) A string search_parameter, which is checked for within nodes of a given type
- *          2) A string type, which indicates the type of node
- * -----------
- * 
- * Returns :
- *          A void* pointer pointing to the ndeo with the given match, or NULL if not found
- * -----------
- * 
- * This function is primarily used during cerating a new node to link various types of
- * nodes as members. Checks only business and individual types since they are the only ones
- * that are used as members
- */
-void *search_to_link(char search_parameter[], char type[]);
+    char *data;
+    size_t used;            // Bytes taken by the posts
+    size_t capacity;
+    int count;              // Number of posts in the chunk
 
-/*
- * Primary function that creates a new node, of all types
- * -----------
- * 
- * Paramters :
- *           A string type, indicating the type of the node
- * -----------
- * 
- * Returns :
- *          Does not return anything but creates a new node and adds it to the global list
- * -----------
- * 
- * Function can take input of all types and required functions are used to do so.
- */
-void new_node(char type[]);
+    long long *times;       // When each post was made, in seconds since the epoch
+    int times_capacity;
+};
 
-/*
- * Function to print one-hop nodes for a node witha  given id
- * -----------
- * 
- * Parameters :
- *          A interger id, which is checked over all nnodes to find a match
- * -----------
- * 
- * Returns :
- *          Prints out all the one-hop nodes to a given nodes
- * -----------
- * 
- * One-hop nodes are the nodes that have a direct connection to the given node
- * Since we maintiain back pointers too, printing all the abck pointed nodes and
- * members if any present in the node will give all the nodes that are firectly linked
- * to the given node
- */
-void one_hop(int id);
+// Size of the first chunk of a node's posts, every next one is twice as big up to POST_CHUNK_MAX
+#define POST_CHUNK_MIN 256
+#define POST_CHUNK_MAX 65536
 
-/*
- *
- * Function to swap two nodes
- * ------------
+/**
+ * @struct post_log
+ * @brief The posts of a node, as a list of chunks
  *
- * Parameters :
- *          Two nodes individual_hop* type nods(pointers) that are to be swapped
- * ------------
+ * A post is copied to the end of the last chunk, or to a new chunk when it doesn't fit, so adding a post never
+ * touches the posts before it. The posts are read in order through a post_cursor, or from the latest one backwards.
+ * Their times never decrease, so the posts of a node are always in the order they were made.
+*/
+struct post_log
+{
+    struct post_chunk *head;
+    struct post_chunk *tail;
 
- * Returns :
- *          Doesn't return anything but just swaps the two given nodes
- * -----------
- * 
- * Since we use this function to swap just the content present in them, we swap their inner contents
- */
-void swap_nodes(struct individual_hop *node_1, struct individual_hop *node_2);
+    int count;              // Number of posts
+    size_t bytes;           // Bytes taken by all the posts, along with their '\0'
+};
 
-/*
- * Function that prints the two-hop individual nodes for a given individual node
- * ------------
- *
- * Parameters :
- *          A single pointer to the requires individual node
- * ------------
- *
- * Returns :
- *          Prints out all the two-hop nodes to the given individual node. Returns nothing as such
- * ------------
- *
- * Two - hop individual nodes are the ones which have a common group or organisation with the given individual node
- * Since we have back pointers to the given node, we can iterate through them to create a linked list of all the individuals
- * present as members in them.
- *
- * Linked list is used so that there is no duplication of two-hop nodes
- */
-void two_hop(struct individual *node);
+/**
+ * @struct post_cursor
+ * @brief Position of the next post to be read from a post_log
+*/
+struct post_cursor
+{
+    struct post_chunk *chunk;
+    size_t offset;
+    int index;              // Number of the post at offset inside the chunk
+};
 
-/*
- * Function that adds content , i.e posts, to already present content of a node
- * ------------
- *
- * Parameters :
- *          There are no required parameters
+/**
+ * @struct feed_item
+ * @brief A post shown in the feed of a node
+*/
+struct feed_item
+{
+    int id;                 // Id of the node that made the post
+    long long time;
+    char *post;
+};
+
+/**
+ * @struct feed_source
+ * @brief One of the neighbours being merged into a feed, with the cursor at it's latest post not yet taken
+*/
+struct feed_source
+{
+    long long time;         // Time of the post right at the cursor
+    char *post;
+    int id;
+    struct post_cursor cursor;
+};
+
+// Buckets of the birthday index, one for every day and month along with bucket 0 for the dates that aren't real
+#define BIRTHDAY_BUCKETS (13 * 32)
+
+/**
+ * @struct birthday_entry
+ * @brief An individual in the birthday index, along with a copy of it's birthday
+*/
+struct birthday_entry
+{
+    int year;
+    int month;
+    int day;
+    int id;
+};
+
+/**
+ * @struct birthday_bucket
+ * @brief The individuals born on the same day of the same month, sorted by their birthday and then by id
+*/
+struct birthday_bucket
+{
+    struct birthday_entry *entries;
+    int count;
+    int capacity;
+};
+
+/**
+ * @struct place
+ * @brief The coordinates of a business, organisation or group in a spatial index
+ *
+ * The id is kept rather than a pointer, so that compacting the memory doesn't have to touch the index.
+*/
+struct place
+{
+    double x;
+    double y;
+    int id;
+    int removed;            // Deleted nodes are only marked till the tree is rebuilt
+};
+
+/**
+ * @struct spatial_index
+ * @brief The places of a single kind, the first tree_count of which form an implicit k-d tree
+ *
+ * The tree is stored without pointers, the root of places[low] to places[high - 1] being the middle one, with the
+ * places having a smaller or equal coordinate before it and the ones with a bigger or equal one after it. The
+ * coordinate is x at even depths and y at odd ones. Places added since the tree was built follow it unsorted, and
+ * the tree is rebuilt by the next query once they, or the places marked removed, grow too many.
+*/
+struct spatial_index
+{
+    struct place *places;
+    int tree_count;         // Places in the tree
+    int count;              // All the places, including the ones added after the tree
+    int capacity;
+    int removed;            // Places in the tree marked removed
+};
+
+/**
+ * @struct place_hit
+ * @brief A place found by a spatial query
+*/
+struct place_hit
+{
+    int id;
+    double distance;        // Squared distance to the point of the query
+};
+
+/**
+ * @struct slab
+ * @brief A block of memory holding many objects of the same size
+ *
+ * Slabs of a pool are linked through the next pointer so that they can be given back. The objects follow
+ * right after the header, which keeps them packed next to each other.
+*/
+struct slab
+{
+    struct slab *next;
+    size_t count; // Number of objects the slab holds
+};
+
+/**
+ * @struct pool
+ * @brief Allocator for objects of a single size, such as the linked_* cells or the nodes
+ *
+ * Memory is taken from the system a slab at a time. Freed objects are kept in a free list (the first bytes of a freed
+ * object point to the next free one) and handed out again before a new slab is allocated, so there is no per-object
+ * header and allocating or freeing an object is O(1).
+*/
+struct pool
+{
+    size_t object_size;
+    void *free_list;
+    struct slab *slabs;
+    size_t in_use;   // Objects currently handed out
+    size_t capacity; // Objects in all the slabs together
+};
+
+/**
+ * @struct slab_use
+ * @brief How full a slab is, worked out by pool_compact()
+ *
+ * The free objects of the slab are free_objects[first_free] to free_objects[first_free + free_count - 1] of the
+ * sorted array of free objects built by pool_compact().
+*/
+struct slab_use
+{
+    struct slab *slab; // Has to stay the first member, the array is sorted by it
+    size_t live;       // Objects in use
+    size_t first_free;
+    size_t free_count;
+};
+
+// Initializer of a pool for objects of the given type
+#define POOL_INIT(type) {sizeof(type), NULL, NULL, 0, 0}
+
+/**
+ * @struct node_kind_info
+ * @brief Table entry describing one kind of node
+ *
+ * The four node structs don't share a common layout past the kind tag, so the position of their common attributes
+ * is stored here. Along with the function used to print the kind, this lets an operation dispatch on the kind once
+ * through kind_info[] instead of comparing type strings for every node.
+*/
+struct node_kind_info
+{
+    char *type; // Name of the kind as shown to the user
+
+    // Offsets of the common attributes inside the struct of the kind
+    size_t id_offset;
+    size_t name_offset;
+    size_t creation_offset;
+    size_t content_offset;
+    size_t posts_offset;
+    size_t csr_index_offset;
+    size_t component_offset;
+    size_t score_offset;
+    size_t next_offset;     // Links of the global list of the kind
+    size_t pprev_offset;
+
+    void (*print)(void *node); // Prints the attributes of a node of the kind
+};
+
+// Table describing each kind, indexed by enum node_kind
+extern const struct node_kind_info kind_info[4];
+
+// Access to the common attributes of a node through a void pointer, using the table of it's kind
+#define NODE_FIELD(node, field_type, field) ((field_type *)((char *)(node) + kind_info[NODE_KIND(node)].field##_offset))
+#define NODE_ID(node) (*NODE_FIELD(node, int, id))
+#define NODE_NAME(node) (*NODE_FIELD(node, char *, name))
+#define NODE_CONTENT(node) (*NODE_FIELD(node, char *, content))
+#define NODE_POSTS(node) (*NODE_FIELD(node, struct post_log *, posts))
+#define NODE_CSR_INDEX(node) (*NODE_FIELD(node, int, csr_index))
+#define NODE_COMPONENT(node) (*NODE_FIELD(node, int, component))
+#define NODE_SCORE(node) (*NODE_FIELD(node, double, score))
+#define NODE_NEXT(node) (*NODE_FIELD(node, void *, next))
+#define NODE_PPREV(node) (*NODE_FIELD(node, void **, pprev))
+
+/**
+ * @struct csr_graph
+ * @brief Compressed sparse row (CSR) snapshot of all the links between the nodes
+ *
+ * Every node gets a dense index from 0 to node_count - 1. The neighbours of the node with dense index i are
+ * neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1], in the same order in which one_hop() prints them, i.e
+ * the back pointers of a node followed by it's members. Walking the arrays replaces chasing the next pointers of the
+ * linked_* cells, which are scattered all over the memory.
+ *
+ * Creating or deleting a node marks the snapshot stale, and it is rebuilt the next time a traversal asks for it.
+*/
+struct csr_graph
+{
+    int node_count;
+    int edge_count;
+
+    void **nodes;           // Dense index -> node
+    unsigned char *kinds;   // Dense index -> enum node_kind, so that filtering by kind doesn't touch the node
+    int *offsets;           // node_count + 1 entries
+    int *neighbors;         // edge_count entries, dense indices of the neighbours
+
+    unsigned int *stamps;   // Per node scratch space for traversals, see two_hop()
+    unsigned int epoch;     // Latest value handed out for the stamps
+
+    int node_capacity;      // Sizes the arrays are allocated for, so that a rebuild can reuse them
+    int edge_capacity;
+
+    int stale;              // Set when the links have changed since the snapshot was built
+};
+
+/**
+ * @struct union_find
+ * @brief Disjoint sets of the nodes, one for every connected component of the graph
+ *
+ * Every node has an element, stored in it's component attribute, whose parent leads to the root of it's set. Links
+ * only ever join two sets, so creating nodes and links updates the sets as they happen. A deletion may split a set,
+ * which union-find can't do, so it only marks the sets dirty and they are built again from the CSR snapshot by
+ * the next query that needs them.
+*/
+struct union_find
+{
+    int *parents;           // Parent of every element, a root being it's own parent
+    int *sizes;             // Number of elements in the set, only kept for the roots
+    int count;
+    int capacity;
+
+    int components;         // Number of sets
+    int dirty;              // Set when the sets no longer match the graph
+};
+
+/**
+ * @struct component_info
+ * @brief A connected component, as listed by components_collect()
+*/
+struct component_info
+{
+    int id;                 // Smallest id of a node in the component
+    int size;
+};
+
+/**
+ * @struct pagerank_state
+ * @brief The graph and score vectors a PageRank computation iterates over
+ *
+ * Every iteration has two phases run by the threads, each over it's own range of nodes. The first divides the score
+ * of every node between it's links into contributions and sums the scores of the nodes without links. The second
+ * pulls the contributions of the neighbours of every node into it's next score, so no two threads write the same
+ * score. The partial sums of every thread are added up between the phases.
+*/
+struct pagerank_state
+{
+    int node_count;
+    const int *offsets;         // The links, as in csr_graph
+    const int *neighbors;
+
+    double *current;            // Score of every dense index, adding up to 1
+    double *next;
+    double *contributions;
+
+    double damping;             // Chance of following a link rather than jumping to any node
+    double base;                // Score every node gets in the iteration without any link
+    double *partials;           // Sum found by every thread in the last phase
+    int threads;
+    int phase;
+};
+
+/**
+ * @struct pagerank_job
+ * @brief A PageRank computation running in the background, on it's own copy of the graph
+ *
+ * The scores are found by id, so they can be handed back to the nodes even if the graph changed meanwhile.
+*/
+struct pagerank_job
+{
+    struct pagerank_state state;
+    int *ids;                   // Id of every dense index of the copy
+    double *vectors;            // Allocation the score vectors of the state point into
+    double tolerance;
+    int max_iterations;
+    int iterations;             // Iterations run, set when the job is done
+
+    pthread_t thread;
+    int running;
+    int done;                   // Set by the thread once the scores are ready
+};
+
+/**
+ * @struct thread_pool
+ * @brief Threads waiting to run a job together with the thread that hands it out
+ *
+ * Handing out a job bumps the generation, which wakes the threads. The calling thread runs the job as worker 0 and
+ * waits till running drops back to 0, so a job costs no thread creation.
+*/
+struct thread_pool
+{
+    pthread_t *threads;             // count - 1 threads, the calling thread being the first worker
+    int count;
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;            // Signalled when a job is handed out or the pool is stopped
+    pthread_cond_t done;            // Signalled when the last thread finishes it's part of a job
+
+    void (*job)(int worker, void *arg);
+    void *arg;
+
+    unsigned int generation;        // Number of jobs handed out so far
+    int running;                    // Threads still running the current job
+    int stopping;
+};
+
+/**
+ * @struct bfs_worker
+ * @brief The queue of chunks and the nodes found by one of the threads expanding a level of a k-hop query
+ *
+ * The chunks left in the queue are next to end - 1. The owner and the threads stealing from it both take a chunk by
+ * an atomic increment of next, so a chunk is never taken twice.
+*/
+struct bfs_worker
+{
+    int *found;                     // Nodes reached by this thread in the level, in the order they were found
+    int count;
+    int capacity;
+    long long links;                // Sum of the number of links of the nodes found
+    int next;
+    int end;
+    int failed;                     // Set if memory allocation failed
+};
+
+/**
+ * @struct k_hop_level
+ * @brief A level of a k-hop query being expanded by the threads
+*/
+struct k_hop_level
+{
+    struct csr_graph *graph;
+    int start;                      // The frontier, k_hop_nodes[start] to k_hop_nodes[end - 1]
+    int end;
+    int bottom_up;
+    int threads;                    // Number of threads sharing the level
+};
+
+// Frontier nodes in a chunk of a top-down step, and nodes in a chunk of a bottom-up step
+#define K_HOP_CHUNK_TOP_DOWN 256
+#define K_HOP_CHUNK_BOTTOM_UP 4096
+
+// Links a top-down step has to go over before it is shared between the threads
+#define K_HOP_PARALLEL_LINKS 65536
+
+/**
+ * @struct content_arena
+ * @brief The contents of all the nodes copied one after the other, for the searches that can't use an index
+ *
+ * The content of the node with dense index i (see csr_graph) starts at text + starts[i] and is followed by a '\0', so
+ * a match of a string without a '\0' never spans two nodes. A single scan over the whole text with a substring kernel
+ * replaces calling strstr() on every content, which are scattered all over the memory.
+ *
+ * Creating or deleting a node or posting content marks the arena stale, and it is rebuilt by the next scan.
+*/
+struct content_arena
+{
+    char *text;
+    size_t size;            // Bytes used in text, every content along with it's '\0'
+    size_t capacity;
+
+    size_t *starts;         // node_count + 1 entries
+    int node_count;
+    int node_capacity;
+
+    int stale;
+};
+
+/**
+ * @struct substring_kernel
+ * @brief A function finding the first occurrence of a pattern in a text, like memmem()
+ *
+ * The scalar kernel runs anywhere. The SIMD ones compare the first and the last byte of the pattern against a whole
+ * block of positions at once and only check the positions where both match, and are used when the machine running
+ * the program supports their instructions.
+*/
+struct substring_kernel
+{
+    char *name;
+    int (*supported)();     // Whether the machine running the program can use the kernel
+
+    // Returns the first position in the size bytes of text where the length bytes of pattern occur, or NULL
+    const char *(*find)(const char *text, size_t size, const char *pattern, size_t length);
+};
+
+// Kernels built into the program, from the slowest to the fastest
+extern const struct substring_kernel substring_kernels[];
+extern const int substring_kernel_count;
+
+/**
+ * @struct pattern_set
+ * @brief Many patterns compiled into a single automaton (Aho-Corasick), finding all of them in one pass over a text
+ *
+ * The trie of the patterns is turned into a DFA: transitions[state * class_count + classes[byte]] is the next state
+ * for every state and byte, so each byte of the text costs a single lookup whatever the number of patterns. Bytes that
+ * no pattern uses share column 0, which leads back to the root, and the two cases of a letter share a column.
+ *
+ * A state where a pattern ends has it in ends[], and match[] leads to the nearest state (the state itself or one
+ * reached through fail[]) where a pattern ends, so every pattern ending at a position is found without trying the
+ * others.
+*/
+struct pattern_set
+{
+    char **patterns;            // Copies of the patterns, numbered from 0
+    int *numbers;               // Number the caller gave each pattern, such as the line it was read from
+    int pattern_count;
+
+    unsigned char classes[256]; // Byte -> column of the transition table
+    int class_count;
+
+    int *transitions;           // state_count * class_count entries
+    int *fail;                  // State for the longest proper suffix that is in the trie
+    int *ends;                  // Pattern ending at the state, or -1
+    int *match;                 // Nearest state at which a pattern ends, 0 if there is none
+    int state_count;
+    int state_capacity;
+
+    unsigned int *seen;         // Per pattern, the scan of the text it was last found in
+    unsigned int epoch;
+};
+
+/**
+ * @struct pattern_match
+ * @brief A pattern found in the content of a node
+*/
+struct pattern_match
+{
+    int id;                     // Id of the node
+    int pattern;                // Number of the pattern in it's pattern_set
+    int number;                 // The number it was given, kept so it still means something once the set is replaced
+};
+
+/**
+ * @struct match_list
+ * @brief Growable array of pattern matches, such as the posts flagged by the blocklist
+*/
+struct match_list
+{
+    struct pattern_match *matches;
+    int count;
+    int capacity;
+};
+
+/**
+ * @struct linked_cell
+ * @brief Common layout of the linked_* cells
+ *
+ * Every linked_* struct is a pointer to a node followed by the next cell, the address of the pointer to the cell and
+ * it's twin, so code that builds, walks or unlinks the lists without looking at the nodes, such as link_member(),
+ * remove_node() and the snapshot loader, can handle all four of them through this struct.
+*/
+struct linked_cell
+{
+    void *node;
+    struct linked_cell *next;
+    struct linked_cell **pprev;
+    struct linked_cell *twin;
+};
+
+// Indexes the nodes of a loaded snapshot are only added to once they are first used, see index_require()
+#define INDEX_NAMES 1
+#define INDEX_WORDS 2       // Along with the trigrams
+#define INDEX_PLACES 4
+#define INDEX_BIRTHDAYS 8
+#define INDEX_ALL 15
+
+// Identifies a snapshot file, the version is bumped whenever the layout below changes
+#define SNAPSHOT_MAGIC "SOCSNAP"
+#define SNAPSHOT_VERSION 5
+
+/**
+ * @struct snapshot_header
+ * @brief First bytes of a snapshot file, telling where each of it's sections is
+ *
+ * A snapshot is made of the header followed by six sections, each an array that can be used right where it is mapped:
+ * the node records, the dates (as struct tm), the times of the posts, the links (dense indices of nodes), the twins
+ * (for every link, the position of the cell of the same link in the other node's lists) and the strings (each ending
+ * in '\0').
+ * The values are stored as they are in memory, so a snapshot can only be loaded on the platform it was saved on.
+*/
+struct snapshot_header
+{
+    char magic[8];
+    int version;
+    int tm_size;            // sizeof(struct tm) when saved
+    long long generation;   // Counts the snapshots saved, the log written after this one carries the same number
+
+    long long node_count;
+    long long date_count;
+    long long link_count;
+    long long string_bytes;
+    long long time_count;   // Number of posts
+
+    long long nodes_offset; // Byte offsets of the sections from the start of the file
+    long long dates_offset;
+    long long times_offset;
+    long long links_offset;
+    long long twins_offset;
+    long long strings_offset;
+};
+
+/**
+ * @struct snapshot_node
+ * @brief Record of a single node in a snapshot
+ *
+ * The nodes are numbered by their position in the file. The link lists of the node are stored one after the other
+ * starting at first_link, in the order csr_node_links() walks them, with the length of each list in list_sizes.
+ * The posts of the node follow it's content in the strings, and are used from the mapping as a single full chunk.
+*/
+struct snapshot_node
+{
+    int id;
+    int kind;
+
+    long long creation;     // Index into the dates
+    long long birthday;     // Index into the dates, -1 if the node has none
+
+    long long name;         // Offsets into the strings
+    long long content;
+    long long posts;        // The posts follow each other from here, post_bytes in all
+    long long post_bytes;
+    long long first_time;   // Index into the times of the first post
+    int post_count;
+
+    double x_cord;
+    double y_cord;
+
+    long long first_link;   // Index into the links
+    int list_sizes[3];
+};
+
+/**
+ * @struct operation_log
+ * @brief Log of every change made since the last snapshot
+ *
+ * Each change is written as a line of the batch language (create, link, post or delete), so replaying the log is
+ * just running it. The first line, "# log <generation>", names the snapshot the log continues from, so that a log
+ * already folded into a newer snapshot is never replayed on top of it.
+ *
+ * Records are buffered and fsync'ed once every sync_every records (group commit), so a crash loses at most the last
+ * sync_every - 1 changes, while the disk only has to sync once per group.
+ *
+ * Names and contents are escaped, a backslash going in front of every backslash and '|' and new lines being written as "\n"
+ * and "\r", so that any string is read back as it was written.
+*/
+struct operation_log
+{
+    FILE *file;             // NULL while there is no log
+    int sync_every;         // Records per fsync, 0 to never fsync
+    int pending;            // Records written since the last fsync
+    int paused;             // Non zero while replaying or loading a snapshot, so those changes aren't logged again
+    int held;               // Non zero while a file is bulk loaded, it's records are synced once at the end of it
+    int replaying;          // Non zero while the log is replayed, so the fields are read back unescaped
+    long long generation;   // Generation of the snapshot the log continues from
+};
+
+/**
+ * @struct snapshot_map
+ * @brief The snapshot file mapped into memory by load_snapshot()
+*/
+struct snapshot_map
+{
+    void *base;
+    size_t size;
+};
+
+/**
+ * @struct loaded_link
+ * @brief A link read from an edge list by load_edges(), with both ends already looked up
+*/
+struct loaded_link
+{
+    void *container;
+    void *member;
+    enum link_role role;
+};
+
+/*
+ * Function to check if a pointer points into the mapped snapshot
+ * -----------
+ *
+ * Parameters :
+ *          Any pointer
+ * -----------
+ *
+ * Returns :
+ *          1 if it points into the snapshot loaded by load_snapshot(), 0 otherwise
+ * -----------
+ *
+ * The names, contents and dates of the nodes loaded from a snapshot are read only, as they are part of the mapping
+ */
+int in_snapshot(void *pointer);
+
+/*
+ * Function to free an attribute of a node
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the name, content or a date of a node
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Memory inside the mapped snapshot is left alone, anything else is freed
+ * -----------
+ */
+void release_memory(void *pointer);
+
+/*
+ * Function to allocate an object from a pool
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the pool of the required type
+ * -----------
+ *
+ * Returns :
+ *          A pointer to the uninitialized object, or NULL if memory allocation failed
+ * -----------
+ *
+ * Takes the object from the free list if there is one, otherwise a new slab is allocated
+ */
+void *pool_alloc(struct pool *pool);
+
+/*
+ * Function to give an object back to it's pool
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the pool the object was allocated from
+ *          2) A pointer to the object
+ * -----------
+ *
+ * Returns :
+ *          Nothing. The object is added to the free list of the pool and will be handed out again
+ * -----------
+ */
+void pool_free(struct pool *pool, void *object);
+
+/*
+ * Function that makes sure a pool can hand out a given number of objects without allocating
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the pool
+ *          2) The number of objects that are about to be allocated
+ * -----------
+ *
+ * Returns :
+ *          1 if the pool has enough free objects, 0 if memory allocation failed
+ * -----------
+ *
+ * Used by the bulk loader so that the slabs for all the nodes or cells of a file are allocated up front
+ */
+int pool_reserve(struct pool *pool, size_t count);
+
+/*
+ * Function that packs the objects of a pool into as few slabs as possible and frees the slabs left empty
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the pool
+ *          2) A function that moves an object to a new address and fixes every pointer to it
+ * -----------
+ *
+ * Returns :
+ *          The number of slabs given back to the system
+ * -----------
+ *
+ * The fullest slabs are kept, just enough of them to hold every object in use, and the objects of the other slabs
+ * are moved into the holes of the kept ones. Takes a single pass over the slabs after sorting the free objects
+ */
+size_t pool_compact(struct pool *pool, void (*move)(void *from, void *to));
+
+/*
+ * Function to mark the CSR snapshot as out of date
+ * -----------
+ *
+ * Parameters : None
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Called by every function that creates or deletes nodes or links
+ * -----------
+ */
+void csr_mark_stale();
+
+/*
+ * Function to get an up to date CSR snapshot of the graph
+ * -----------
+ *
+ * Parameters : None
+ * -----------
+ *
+ * Returns :
+ *          A pointer to the snapshot, or NULL if memory allocation failed
+ * -----------
+ *
+ * Rebuilds the snapshot in two passes over the global lists if it is stale, reusing the arrays of the previous
+ * snapshot when they are big enough. Otherwise the snapshot is returned as it is, so reads pay nothing
+ */
+struct csr_graph *csr_snapshot();
+
+/*
+ * Function that makes sure the ID index can hold a given number of nodes without growing
+ * -----------
+ *
+ * Parameters :
+ *          An integer count, the number of nodes the index should be able to hold
+ * -----------
+ *
+ * Returns :
+ *          1 if the index has enough space, 0 if memory allocation failed
+ * -----------
+ *
+ * The table is kept at most 70% full, so the capacity is rounded up to a power of two above count / 0.7
+ */
+int id_index_reserve(int count);
+
+/*
+ * Function to add a node to the ID index
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The kind of the node
+ *          3) A void pointer to the node itself
+ * -----------
+ *
+ * Returns :
+ *          1 if the node was added, 0 if a node with the same id already exists or memory allocation failed
+ * -----------
+ *
+ * Used by the create paths so that every node present in the global lists can be found by it's id in O(1)
+ */
+int id_index_insert(int id, enum node_kind kind, void *node);
+
+/*
+ * Function to find the slot of a node in the ID index
+ * -----------
+ *
+ * Parameters :
+ *          An integer id, which is unique to each node
+ * -----------
+ *
+ * Returns :
+ *          A pointer to the slot holding the node and it's kind, or NULL if no such node exists
+ * -----------
+ *
+ * Does not print anything, so it can be used to check for duplicate ids too
+ */
+struct id_slot *id_index_find(int id);
+
+/*
+ * Function to remove a node from the ID index
+ * -----------
+ *
+ * Parameters :
+ *          An integer id, the id of the node being deleted
+ * -----------
+ *
+ * Returns :
+ *          Nothing. The slot is turned into a tombstone so that the probe sequences of other ids stay intact
+ * -----------
+ */
+void id_index_remove(int id);
+
+/*
+ * Function that makes sure the name index of a kind can hold a given number of nodes without growing
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the nodes
+ *          2) An integer count, the number of nodes the index should be able to hold
+ * -----------
+ *
+ * Returns :
+ *          1 if the index has enough buckets, 0 if memory allocation failed
+ * -----------
+ */
+int name_index_reserve(enum node_kind kind, int count);
+
+/*
+ * Function to add a node to the name index of it's kind
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the node
+ *          2) A string name, the name of the node
+ *          3) A void pointer to the node itself
+ * -----------
+ *
+ * Returns :
+ *          1 if the node was added, 0 if memory allocation failed
+ * -----------
+ *
+ * Duplicate names are allowed, the newest node with a name is found first just like in the global lists
+ */
+int name_index_insert(enum node_kind kind, char *name, void *node);
+
+/*
+ * Function to find the first node of a kind with a given name
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the node
+ *          2) A string name, which is to be searched for
+ * -----------
+ *
+ * Returns :
+ *          The entry of the first node with the name, or NULL if there is none
+ * -----------
+ *
+ * The other nodes with the same name are found by passing the returned entry to name_index_next()
+ */
+struct name_entry *name_index_find(enum node_kind kind, char *name);
+
+/*
+ * Function to find the next node with the same name as a given entry
+ * -----------
+ *
+ * Parameters :
+ *          A name_entry pointer returned by name_index_find() or name_index_next()
+ * -----------
+ *
+ * Returns :
+ *          The entry of the next node with the same name, or NULL if there are no more
+ * -----------
+ */
+struct name_entry *name_index_next(struct name_entry *entry);
+
+/*
+ * Function to remove a node from the name index of it's kind
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the node
+ *          2) A string name, the name of the node
+ *          3) A void pointer to the node itself, so that only it is removed and not other nodes with the same name
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Has to be called before the name of the node is freed
+ * -----------
+ */
+void name_index_remove(enum node_kind kind, char *name, void *node);
+
+/*
+ * Function to point the entry of a node in the name index to the node's new address
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the node
+ *          2) A string name, the name of the node
+ *          3) The old address of the node
+ *          4) The new address of the node
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Used when the nodes are compacted
+ * -----------
+ */
+void name_index_move(enum node_kind kind, char *name, void *from, void *to);
+
+/*
+ * Function to read the next word of a text
+ * -----------
+ *
+ * Parameters :
+ *          1) A string text
+ *          2) A char array of atleast WORD_LIMIT + 1 characters, where the word is stored lowercased
+ * -----------
+ *
+ * Returns :
+ *          A pointer right after the word, to read the next one from, or NULL if the text has no more words
+ * -----------
+ */
+char *next_word(char *text, char word[]);
+
+/*
+ * Function to add the words of a text to the word index
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node using the words
+ *          2) A string text, the content or a new post of the node
+ * -----------
+ *
+ * Returns :
+ *          1 on success, 0 if memory allocation failed. A word is only stored once per node, however often it is used
+ * -----------
+ */
+int word_index_add(int id, char *text);
+
+/*
+ * Function to remove a node from the word index
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) A string text, the whole content of the node
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Words no longer used by any node are dropped from the index
+ * -----------
+ */
+void word_index_remove(int id, char *text);
+
+/*
+ * Function to add the trigrams of a text to the trigram index
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node using the text
+ *          2) A string text, the content of the node or the part of it that was just posted
+ * -----------
+ *
+ * Returns :
+ *          1 on success, 0 if memory allocation failed. A trigram is only stored once per node
+ * -----------
+ */
+int trigram_index_add(int id, char *text);
+
+/*
+ * Function to remove a node from the trigram index
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) A string text, the whole content of the node
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Trigrams no longer used by any node are dropped from the index
+ * -----------
+ */
+void trigram_index_remove(int id, char *text);
+
+/*
+ * Function to choose the substring kernel used by the scans
+ * -----------
+ *
+ * Parameters :
+ *          None
+ * -----------
+ *
+ * Returns :
+ *          The fastest kernel of substring_kernels[] the machine running the program supports, chosen on the first call
+ * -----------
+ */
+const struct substring_kernel *substring_kernel_select();
+
+/*
+ * Function to mark the content arena as out of date
+ * -----------
+ *
+ * Parameters :
+ *          None
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Called whenever a content changes or a node is created or deleted
+ * -----------
+ */
+void content_arena_mark_stale();
+
+/*
+ * Function to get the content arena
+ * -----------
+ *
+ * Parameters :
+ *          An up to date CSR snapshot, whose dense indices give the order of the contents
+ * -----------
+ *
+ * Returns :
+ *          The arena, rebuilt first if it was stale, or NULL if memory allocation failed
+ * -----------
+ */
+struct content_arena *content_arena_build(struct csr_graph *graph);
+
+/*
+ * Function to compile some patterns into a pattern set
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the pattern set, whatever it held before is freed
+ *          2) An array of the patterns. Empty patterns are skipped, and a repeated pattern is only kept once
+ *          3) An array with a number for each pattern, kept in numbers[], or NULL to number them from 1 by position.
+ *             A pattern kept once keeps the number of it's first copy
+ *          4) The number of patterns in the array
+ * -----------
+ *
+ * Returns :
+ *          1 if the patterns were compiled, 0 if memory allocation failed, which leaves the set empty
+ * -----------
+ */
+int pattern_set_compile(struct pattern_set *set, char **patterns, int *numbers, int count);
+
+/*
+ * Function to free everything held by a pattern set
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the pattern set
+ * -----------
+ *
+ * Returns :
+ *          Nothing. The set is left empty, matching nothing
+ * -----------
+ */
+void pattern_set_clear(struct pattern_set *set);
+
+/*
+ * Function to load the blocklist, the phrases every new post is checked against
+ * -----------
+ *
+ * Parameters :
+ *          A FILE pointer to read the phrases from, one per line. Empty lines are skipped
+ * -----------
+ *
+ * Returns :
+ *          The number of phrases loaded, or -1 if the file couldn't be read or memory allocation failed
+ * -----------
+ *
+ * The phrases are matched anywhere in a content, without case. Each phrase is numbered by it's line in the file, so
+ * the same phrase twice (in either case) is reported by it's first line
+ */
+int blocklist_load(FILE *input);
+
+/*
+ * Function to find every blocked phrase in every content
+ * -----------
+ *
+ * Parameters :
+ *          None
+ * -----------
+ *
+ * Returns :
+ *          The number of (node, phrase) pairs found, or -1 if memory allocation failed. The pairs are left in
+ *          found_matches, in the order of the global lists
+ * -----------
+ *
+ * All the contents are scanned once through the content arena, whatever the number of phrases
+ */
+int blocklist_search();
+
+/*
+ * Function to check a new post against the blocklist
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node posting
+ *          2) A string post, the post alone
+ * -----------
+ *
+ * Returns :
+ *          The number of blocked phrases in the post, or -1 if memory allocation failed. A (node, phrase) pair is
+ *          added to flagged_posts for each of them
+ * -----------
+ *
+ * Called by post_content() for every post
+ */
+int blocklist_check(int id, char *post);
+
+/*
+ * Takes input from the user character by character so that spaces are included too.
+ * -----------
+ * 
+ * Parameters : None
+ * -----------
+ * 
+ * Returns : A char pointer(array) with the name string
+ * -----------
+ * 
+ * The string ends when a new line character is detected
+ */
+char *name_input();
+
+/*
+ * Function to take input of date from the user
+ * -----------
+ * 
+ * Parameters : None
+ * -----------
+ * 
+ * Returns : A struct tm type pointer of a structure containing the date
+ * -----------
+ *
+ * If the date entered is wrong, -1 is returned for the day,month and year
+ */
+struct tm *date_input();
+
+/*
+ * Takes input for the "Content" attribute of a node
+ * -----------
+ * 
+ * Parameters : None
+ * -----------
+ * 
+ * Returns : A char type pointer(array) of the content string
+ * -----------
+ * 
+ * Works similar to the name_input function
+ */
+char *content_input();
+
+/*
+ * Function to take input of birthday from the user
+ * -----------
+ * 
+ * Parameters : None
+ * -----------
+ * 
+ * Returns : A struct tm type pointer of a structure containing the birthday
+ * -----------
+ * 
+ * Uses the name-input function if the user want's to input a birthday, otherwise a known invalid date is given
+ */
+struct tm *birthday_input();
+
+/*
+ * Function to find the kind of node a type string refers to
+ * -----------
+ *
+ * Parameters :
+ *          A string type, such as "Individual" or "Group"
+ * -----------
+ *
+ * Returns :
+ *          The matching enum node_kind, or -1 if the string is not a type
+ * -----------
+ *
+ * Used only where a type is given as text by the user, everything else passes the kind around
+ */
+int kind_from_type(char type[]);
+
+/*
+ * Function to print a given node
+ * -----------
+ * 
+ * Parameters :
+ *          A node pointer of the type Void so that it can be typecasted to the required type
+ * -----------
+ * 
+ * Returns :
+ *          Prints out the content of the node
+ * -----------
+ * 
+ * Reads the kind tag of the node and prints it's attributes through the print function of that kind
+ */
+void print_node(void *node);
+
+/*
+ * Function to search for a given node and print it
+ * -----------
+ * 
+ * Parameters :
+ *          A string search_parameter, i.e the parameter the user wants to search for
+ * -----------
+ * 
+ * Returns :
+ *          Prints out the content of the node if it's required parameter matches with the given search_parameter
+ * -----------
+ * 
+ * Used to print nodes if the user gives name or type as the search parameter.
+ * Nodes with a matching name are found through the name indexes, all the nodes of a type are printed from the global lists
+ */
+void search(char search_parameter[]);
+
+/*
+ * Function to search for a given node and print it
+ * -----------
+ * 
+ * Parameters :
+ *          An integer id, which is unique to each node
+ * -----------
+ * 
+ * Returns :
+ *          returns a pointer of the the type void*, i.e it can be typecasted later
+ * -----------
+ * 
+ * Looks up the global ID index, so the node is found in O(1) instead of running over the global linked lists
+ */
+void *search_by_id(int id);
+
+/*
+ * Function that searches for a given birthday
+ * -----------
+ * 
+ * Parameters :
+ *          A struct tm (time) search_date, that contains the date to be searched
+ * -----------
+ * 
+ * Returns :
+ *          Prints out all the (individual) nodes with the given birthday
+ * -----------
+ * 
+ * Looks up the birthday index through birthdays_on(), so only the individuals born on the same date are looked at
+ *
+ */
+void search_by_birthday(struct tm *search_date);
+
+/*
+ * Function to print the content of a node with a given id
+ * -----------
+ * 
+ * Parameters :
+ *          A integer id, which is unique for each node
+ * -----------
+ * 
+ * Returns ;
+ *          Prints out the content (attributes) in an orderly fashion
+ * -----------
+ * 
+ * AS the id is unique for each node, the node is found through the ID index.
+ * No match is taken care of.
+ */
+void print_content(int id);
+
+/*
+ * Function to print the whole content of a node
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the node
+ * -----------
+ *
+ * Returns :
+ *          Prints the content the node was created with, followed by each of it's posts after two new lines
+ * -----------
+ *
+ * The posts are streamed from their chunks, no single string with all of them is ever built
+ */
+void print_whole_content(void *node);
+
+/*
+ * Function to print some posts of a node, a page at a time
+ * -----------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The number of the first post to print, the posts being numbered from 0 in the order they were made
+ *          3) The number of posts to print atmost
+ * -----------
+ *
+ * Returns :
+ *          The number of posts printed, one per line, or -1 if there is no node with the id
+ * -----------
+ */
+int print_posts(int id, int first, int count);
+
+/*
+ * Funtion that returns nodes with the matching search_parameeter and type,
+ * which are then linked in
+ * -----------
+ * 
+ * Parameters :
+ *          1) A string search_parameter, which is checked for within nodes of a given type
+ *          2) The kind of node to be searched
+ * -----------
+ * 
+ * Returns :
+ *          A void* pointer pointing to the ndeo with the given match, or NULL if not found
+ * -----------
+ * 
+ * This function is primarily used during cerating a new node to link various types of
+ * nodes as members. Checks only business and individual types since they are the only ones
+ * that are used as members. The node is found through the name index in O(1) expected time
+ */
+void *search_to_link(char search_parameter[], enum node_kind kind);
+
+/*
+ * Function that creates a node of any type from it's attributes, without any input from the user
+ * -----------
+ *
+ * Parameters :
+ *          1) The kind of the node
+ *          2) An integer id, which has to be unique
+ *          3) The name, creation date and content of the node, which are owned by the node from now on
+ *          4) The birthday of the node, only used for individuals (NULL otherwise)
+ *          5) The co-ordinates of the node, not used for individuals
+ * -----------
+ *
+ * Returns :
+ *          A pointer to the new node, or NULL if the id is already in use or memory allocation failed.
+ *          The attributes are not freed if the node could not be created
+ * -----------
+ *
+ * The node is added to it's global list and the indexes. The members are linked afterwards through link_member()
+ */
+void *create_node(enum node_kind kind, int id, char *name, struct tm *creation, char *content, struct tm *birthday, double x_cord, double y_cord);
+
+/*
+ * Function that links a member to a business, organisation or group
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the business, organisation or group
+ *          2) A pointer to the individual or business to be linked
+ *          3) The role of the member, owner or customer for businesses and member otherwise
+ * -----------
+ *
+ * Returns :
+ *          1 if the member was linked, 0 if such a link can't exist or memory allocation failed
+ * -----------
+ *
+ * Adds the member to the list of the role in the container, and the container to the back pointers of the member
+ */
+int link_member(void *container, void *member, enum link_role role);
+
+/*
+ * Primary function that creates a new node, of all types
+ * -----------
+ * 
+ * Paramters :
+ *           The kind of the node to be created
+ * -----------
+ * 
+ * Returns :
+ *          Does not return anything but creates a new node and adds it to the global list
+ * -----------
+ * 
+ * Function can take input of all types and required functions are used to do so.
+ * The node itself is created through create_node() and it's members are linked through link_member()
+ */
+void new_node(enum node_kind kind);
+
+/*
+ * Function to print one-hop nodes for a node witha  given id
+ * -----------
+ * 
+ * Parameters :
+ *          A interger id, which is checked over all nnodes to find a match
+ * -----------
+ * 
+ * Returns :
+ *          Prints out all the one-hop nodes to a given nodes
+ * -----------
+ * 
+ * One-hop nodes are the nodes that have a direct connection to the given node
+ * Since we maintiain back pointers too, printing all the abck pointed nodes and
+ * members if any present in the node will give all the nodes that are firectly linked
+ * to the given node. These are read from the CSR snapshot of the graph
+ */
+void one_hop(int id);
+
+/*
+ * Function that collects the two-hop individual nodes for a given individual node
+ * ------------
+ *
+ * Parameters :
+ *          A single pointer to the requires individual node
+ * ------------
+ *
+ * Returns :
+ *          The number of two-hop nodes, or -1 if memory allocation failed. Their dense indices in the CSR
+ *          snapshot are stored in the two-hop buffer, in the order they were found
+ * ------------
+ */
+int two_hop_collect(struct individual *node);
+
+/*
+ * Function that collects the nodes within a number of hops of a given node
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The number of hops, links of any kind are followed
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes reached, not counting the node itself, or -1 if there is no node with the id or memory
+ *          allocation failed. Their dense indices in the CSR snapshot are stored in k_hop_nodes[] level by level,
+ *          k_hop_nodes[0] being the node itself and the nodes d hops away being k_hop_nodes[k_hop_ends[d - 1]] to
+ *          k_hop_nodes[k_hop_ends[d] - 1]. Each level is sorted, so the result is the same for any number of threads
+ * ------------
+ *
+ * The levels are found one at a time. A level is found top-down, by going over the links of the last one, while the
+ * last level is small, and bottom-up, by every node not reached yet looking for a link into the last level kept as a
+ * bitmap, once the last level has more links than a fraction of the nodes left. The bottom-up steps stop looking at
+ * a node on it's first link into the last level, which saves most of the work on the big middle levels.
+ *
+ * Big levels are split into chunks shared by the threads of the pool, see thread_pool_start(). The nodes reached are
+ * marked in a bitmap with atomic operations, and a thread done with it's own chunks takes the ones left to the others
+ */
+int k_hop_collect(int id, int hops);
+
+/*
+ * Function that prints the number of nodes within a number of hops of a node
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The number of hops
+ * ------------
+ *
+ * Returns :
+ *          Prints out the number of nodes at each distance and the total, without printing the nodes themselves.
+ *          A negative number of hops, a missing node and a memory allocation failure each get their own message
+ * ------------
+ */
+void print_k_hop(int id, int hops);
+
+/*
+ * Function that finds the shortest path between two nodes
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer from, the id of the node the path starts at
+ *          2) An integer to, the id of the node the path ends at
+ * ------------
+ *
+ * Returns :
+ *          The number of links on the path, -1 if the nodes aren't connected, or -2 if either node doesn't exist or
+ *          memory allocation failed. The dense indices of the nodes on the path are stored in path_nodes[], from the
+ *          first node to the second one
+ * ------------
+ *
+ * A BFS is run from both nodes, a whole level at a time from the side whose last level has fewer links, till the
+ * two meet. Each side only goes about half the distance, so on a graph where the number of nodes reached grows
+ * quickly with the distance, the two sides together reach about the square root of the nodes a single BFS would
+ */
+int shortest_path(int from, int to);
+
+/*
+ * Function that prints the shortest path between two nodes
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer from, the id of the first node
+ *          2) An integer to, the id of the second node
+ * ------------
+ *
+ * Returns :
+ *          Prints out the nodes on the path along with their types, such as an individual, the group it is a member
+ *          of and another member of the group
+ * ------------
+ */
+void print_shortest_path(int from, int to);
+
+/*
+ * Functions that keep the connected components up to date
+ * ------------
+ *
+ * Parameters :
+ *          The node just created for components_add_node(), the two nodes just linked for components_add_link()
+ * ------------
+ *
+ * Returns :
+ *          Nothing. components_mark_dirty() is called by a deletion, which leaves the components to be built again
+ * ------------
+ */
+void components_add_node(void *node);
+void components_add_link(void *a, void *b);
+void components_mark_dirty();
+
+/*
+ * Function that builds the connected components again from the CSR snapshot
+ * ------------
+ *
+ * Parameters :
+ *          None
+ * ------------
+ *
+ * Returns :
+ *          1 if the components were built, 0 if memory allocation failed
+ * ------------
+ *
+ * Every node gets the element of it's dense index, and the elements at the two ends of every link are joined. Only
+ * needed after a deletion or loading a snapshot, creating nodes and links keep the components up to date
+ */
+int components_rebuild();
+
+/*
+ * Function that tells if two nodes are connected
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer a, the id of the first node
+ *          2) An integer b, the id of the second node
+ * ------------
+ *
+ * Returns :
+ *          1 if there is a path between the nodes, 0 if there isn't, or -1 if either node doesn't exist or memory
+ *          allocation failed
+ * ------------
+ *
+ * Finding the roots of the two elements takes close to O(1), as the sets are joined by size and the paths are
+ * halved on every find
+ */
+int nodes_connected(int a, int b);
+
+/*
+ * Function that lists the connected components
+ * ------------
+ *
+ * Parameters :
+ *          None
+ * ------------
+ *
+ * Returns :
+ *          The number of components, or -1 if memory allocation failed. They are left in found_components[], the
+ *          biggest first and then by the smallest id in them
+ * ------------
+ */
+int components_collect();
+
+/*
+ * Function that prints the connected components
+ * ------------
+ *
+ * Parameters :
+ *          None
+ * ------------
+ *
+ * Returns :
+ *          Prints out the number of components and the size of each, along with a node in it
+ * ------------
+ */
+void print_components();
+
+/*
+ * Function that scores the influence of every node with PageRank
+ * ------------
+ *
+ * Parameters :
+ *          1) The damping factor, the chance of following a link rather than jumping to any node, usually 0.85
+ *          2) The tolerance, the iterations stop once the scores change by less than it in total
+ *          3) The number of iterations to be run atmost
+ * ------------
+ *
+ * Returns :
+ *          The number of iterations run, or -1 if memory allocation failed. The score of every node is stored in it's
+ *          score attribute, the scores adding up to 1
+ * ------------
+ *
+ * Iterates over the CSR snapshot, every node pulling the scores of it's neighbours, on the threads of the pool (see
+ * thread_pool_start()). The scores of the last computation are the starting point, so a graph that changed a
+ * little converges in a few iterations. A node without links hands it's score out to all the nodes
+ */
+int pagerank_compute(double damping, double tolerance, int max_iterations);
+
+/*
+ * Function that starts scoring the nodes with PageRank in the background
+ * ------------
+ *
+ * Parameters :
+ *          Same as pagerank_compute()
+ * ------------
+ *
+ * Returns :
+ *          1 if the computation was started, 0 if one is already running or it couldn't be started
+ * ------------
+ *
+ * The graph and the scores are copied, so the network can be used and changed while the scores are found. The
+ * scores are handed to the nodes by pagerank_poll(), nodes deleted meanwhile are skipped and new ones keep their score
+ */
+int pagerank_refresh(double damping, double tolerance, int max_iterations);
+
+/*
+ * Function that hands the scores found in the background to the nodes, if they are ready
+ * ------------
+ *
+ * Parameters :
+ *          An integer wait, 1 to wait for a computation still running and 0 to leave it running
+ * ------------
+ *
+ * Returns :
+ *          1 if scores were handed to the nodes, 0 otherwise
+ * ------------
+ */
+int pagerank_poll(int wait);
+
+/*
+ * Function that finds the nodes with the highest scores
+ * ------------
+ *
+ * Parameters :
+ *          1) The kind of the nodes wanted, or -1 for all of them
+ *          2) The number of nodes wanted
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes found, atmost the number asked for, or -1 if memory allocation failed. They are left
+ *          in found_nodes[], the highest score first and then by id
+ * ------------
+ */
+int top_scores(int kind, int count);
+
+/*
+ * Function that prints the nodes with the highest scores
+ * ------------
+ *
+ * Parameters :
+ *          1) The kind of the nodes wanted, or -1 for all of them
+ *          2) The number of nodes to be printed atmost
+ * ------------
+ *
+ * Returns :
+ *          Prints out the nodes along with their scores, computing the scores first if needed
+ * ------------
+ */
+void print_top_scores(int kind, int count);
+
+/*
+ * Function that sets the number of threads the k-hop queries and PageRank run on
+ * ------------
+ *
+ * Parameters :
+ *          An integer threads, the number of threads including the calling one. 1 runs everything on the calling thread
+ * ------------
+ *
+ * Returns :
+ *          1 if the threads were started, 0 otherwise. A thread that can't be created leaves the pool smaller
+ * ------------
+ *
+ * The threads already running are stopped first, they wait for jobs without using the CPU till then
+ */
+int thread_pool_start(int threads);
+
+/*
+ * Function that stops the threads of the pool
+ * ------------
+ *
+ * Parameters :
+ *          None
+ * ------------
+ *
+ * Returns :
+ *          Nothing, the k-hop queries run on the calling thread alone afterwards
+ * ------------
+ */
+void thread_pool_stop();
+
+/*
+ * Function that prints the two-hop individual nodes for a given individual node
+ * ------------
+ *
+ * Parameters :
+ *          A single pointer to the requires individual node
+ * ------------
+ *
+ * Returns :
+ *          Prints out all the two-hop nodes to the given individual node. Returns nothing as such
+ * ------------
+ *
+ * Two - hop individual nodes are the ones which have a common group or organisation with the given individual node
+ * Since we have back pointers to the given node, we can iterate through them to collect all the individuals
+ * present as members in them.
+ *
+ * The traversal runs over the CSR snapshot of the graph. Every query gets a new epoch number which is stamped on the
+ * individuals it reaches, so an individual is a duplicate exactly when it already carries the current epoch. The two-hop
+ * nodes are collected in a buffer that is reused by every query, so a query takes time proportional to the sizes of
+ * the member lists and allocates nothing
+ */
+void two_hop(struct individual *node);
+
+/*
+ * Function that adds a post to the already present content of a node, without any input from the user
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) A string, the post to be added. It is copied, so the caller still owns it
+ * ------------
+ *
+ * Returns :
+ *          1 if the post was added, 0 if there is no node with the id and -1 if memory allocation failed
+ * ------------
+ *
+ * A post with a blocked phrase is added all the same, and flagged in flagged_posts (see blocklist_check())
+ */
+int post_content(int id, char *new_content);
+
+/*
+ * Function to add a post to the end of a post log
+ * -----------
+ *
+ * Parameters :
+ *          1) The address of the node's post_log pointer, the log is created on the first post
+ *          2) A string, the post. It is copied, so the caller still owns it
+ *          3) The time of the post, in seconds since the epoch. A time before the latest post is taken as that one's
+ * -----------
+ *
+ * Returns :
+ *          1 if the post was added, -1 if memory allocation failed
+ * -----------
+ *
+ * Takes O(length of the post), the posts already there are never copied
+ */
+int post_log_append(struct post_log **log, char *post, long long time);
+
+/*
+ * Function to take the latest post back off the end of a post log
+ * -----------
+ *
+ * Parameters :
+ *          The address of the node's post_log pointer, the log has to have a post added by post_log_append()
+ * -----------
+ *
+ * Returns :
+ *          Nothing. A chunk left without posts is freed, and so is the log, setting the pointer to NULL
+ * -----------
+ *
+ * Used to undo a post that couldn't be indexed
+ */
+void post_log_drop_last(struct post_log **log);
+
+/*
+ * Function to add posts that are already stored one after the other, such as in a mapped snapshot, to a post log
+ * -----------
+ *
+ * Parameters :
+ *          1) The address of the node's post_log pointer, the log is created if needed
+ *          2) A pointer to the posts, each ending with a '\0'. They are used where they are, and never written to
+ *          3) The number of posts
+ *          4) The number of bytes they take, along with their '\0'
+ *          5) The times of the posts, used where they are too. They shouldn't decrease
+ * -----------
+ *
+ * Returns :
+ *          1 if the posts were added, -1 if memory allocation failed
+ * -----------
+ */
+int post_log_map(struct post_log **log, char *posts, int count, size_t bytes, long long *times);
+
+/*
+ * Function to free a post log
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the post log, NULL being a log with no posts
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Posts that are part of a mapped snapshot are left in the mapping
+ * -----------
+ */
+void post_log_free(struct post_log *log);
+
+/*
+ * Function to start reading a post log from a given post
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the post log, NULL being a log with no posts
+ *          2) The number of the first post to read, from 0
+ *          3) A pointer to the cursor to be set
+ * -----------
+ *
+ * Returns :
+ *          Nothing. Whole chunks before the post are skipped without looking at their posts
+ * -----------
+ */
+void post_log_seek(struct post_log *log, int first, struct post_cursor *cursor);
+
+/*
+ * Function to read the next post from a cursor
+ * -----------
+ *
+ * Parameters :
+ *          A pointer to the cursor, set by post_log_seek()
+ * -----------
+ *
+ * Returns :
+ *          The post, or NULL once every post has been read
+ * -----------
+ */
+char *post_log_next(struct post_cursor *cursor);
+
+/*
+ * Function to start reading a post log backwards, from the latest post
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the post log, NULL being a log with no posts
+ *          2) A pointer to the cursor to be set, right after the latest post
+ * -----------
+ *
+ * Returns :
+ *          Nothing
+ * -----------
+ */
+void post_log_seek_end(struct post_log *log, struct post_cursor *cursor);
+
+/*
+ * Function to read the post before a cursor
+ * -----------
+ *
+ * Parameters :
+ *          1) A pointer to the cursor, set by post_log_seek_end() or moved by this function
+ *          2) A pointer to store the time of the post at
+ * -----------
+ *
+ * Returns :
+ *          The post, or NULL once the first post has been read
+ * -----------
+ */
+char *post_log_prev(struct post_cursor *cursor, long long *time);
+
+/*
+ * Function that adds a post made at a given time, without any input from the user
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) A string, the post to be added. It is copied, so the caller still owns it
+ *          3) The time of the post, in seconds since the epoch
+ * ------------
+ *
+ * Returns :
+ *          The same as post_content(), which is this with the current time
+ * ------------
+ *
+ * The post is logged with it's time, so that replaying the log gives it the same time
+ */
+int post_content_at(int id, char *new_content, long long time);
+
+/*
+ * Function that collects the latest posts made by the one-hop nodes of a node
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The number of posts wanted
+ * ------------
+ *
+ * Returns :
+ *          The number of posts collected, atmost the number asked for, or -1 if there is no node with the id or memory
+ *          allocation failed. The posts are left in feed_items[], latest first
+ * ------------
+ *
+ * The one-hop nodes are the ones one_hop() prints. The latest post of every one of them is kept in a max-heap by time,
+ * and each post taken from the heap is replaced by the one made before it by the same node, so collecting K posts
+ * from d nodes takes O(d + K log d) without looking at the older posts
+ */
+int feed_collect(int id, int count);
+
+/*
+ * Function that prints the feed of a node
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the node
+ *          2) The number of posts to be printed atmost
+ * ------------
+ *
+ * Returns :
+ *          Prints out the latest posts of the one-hop nodes of the node, latest first, along with who made them and when
+ * ------------
+ */
+void print_feed(int id, int count);
+
+/*
+ * Function that adds a node to the spatial index of it's kind
+ * ------------
+ *
+ * Parameters :
+ *          A void pointer node, the node just created. Individuals have no coordinates and are left out
+ * ------------
+ *
+ * Returns :
+ *          1 on success, 0 if memory allocation failed. The node is kept outside the tree till the next rebuild
+ * ------------
+ */
+int spatial_index_insert(void *node);
+
+/*
+ * Function that removes a node from the spatial index of it's kind
+ * ------------
+ *
+ * Parameters :
+ *          A void pointer node, the node being deleted
+ * ------------
+ *
+ * Returns :
+ *          Nothing, the node is found by it's coordinates in O(log n) and marked removed
+ * ------------
+ */
+void spatial_index_remove(void *node);
+
+/*
+ * Function that finds the nodes within a radius of a point
+ * ------------
+ *
+ * Parameters :
+ *          1) The kind of the nodes wanted, or -1 for businesses, organisations and groups alike
+ *          2) The x and y coordinates of the point
+ *          3) The radius
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes found. They are left in found_places[], nearest first and then by id
+ * ------------
+ */
+int places_within(int kind, double x, double y, double radius);
+
+/*
+ * Function that finds the nodes inside a box
+ * ------------
+ *
+ * Parameters :
+ *          1) The kind of the nodes wanted, or -1 for businesses, organisations and groups alike
+ *          2) The x and y coordinates of one corner of the box
+ *          3) The x and y coordinates of the opposite corner, the edges of the box are included
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes found. They are left in found_places[], by id
+ * ------------
+ */
+int places_in_box(int kind, double x1, double y1, double x2, double y2);
+
+/*
+ * Function that finds the nodes nearest to a point
+ * ------------
+ *
+ * Parameters :
+ *          1) The kind of the nodes wanted, or -1 for businesses, organisations and groups alike
+ *          2) The x and y coordinates of the point
+ *          3) The number of nodes wanted
+ *          4) The id of a node to be left out, such as the one the point belongs to
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes found, atmost the number asked for. They are left in found_places[], nearest first
+ *          and then by id
+ * ------------
+ *
+ * Only the parts of the tree that can hold a node nearer than the farthest one kept so far are visited, which
+ * takes O(log n) for a small number of nodes
+ */
+int places_nearest(int kind, double x, double y, int count, int exclude);
+
+/*
+ * Function that prints the nodes nearest to a node
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of a business, organisation or group
+ *          2) The kind of the nodes wanted, or -1 for businesses, organisations and groups alike
+ *          3) The number of nodes to be printed atmost
+ * ------------
+ *
+ * Returns :
+ *          Prints out the nodes nearest to the node, nearest first
+ * ------------
+ */
+void print_places_near(int id, int kind, int count);
+
+/*
+ * Function that adds an individual to the birthday index
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the individual
+ *          2) A struct tm pointer birthday, the birthday of the individual. Individuals without one are left out
+ * ------------
+ *
+ * Returns :
+ *          1 if the individual was added or has no birthday, 0 if memory allocation failed
+ * ------------
+ */
+int birthday_index_insert(int id, struct tm *birthday);
+
+/*
+ * Function that removes an individual from the birthday index
+ * ------------
+ *
+ * Parameters :
+ *          1) An integer id, the id of the individual
+ *          2) A struct tm pointer birthday, the birthday it was added with
+ * ------------
+ *
+ * Returns :
+ *          Nothing
+ * ------------
+ */
+void birthday_index_remove(int id, struct tm *birthday);
+
+/*
+ * Function that finds the individuals born on a date
+ * ------------
+ *
+ * Parameters :
+ *          The day, month and year of the birthday
+ * ------------
+ *
+ * Returns :
+ *          The number of individuals found, or -1 if memory allocation failed. They are left in found_nodes[],
+ *          in the order of the global list
+ * ------------
+ *
+ * Only the bucket of the day and month is looked at, and the year is found in it by a binary search
+ */
+int birthdays_on(int day, int month, int year);
+
+/*
+ * Function that finds the individuals born on a day and month, of any year
+ * ------------
+ *
+ * Parameters :
+ *          The day and month of the birthday
+ * ------------
+ *
+ * Returns :
+ *          The number of individuals found, or -1 if memory allocation failed. They are left in found_nodes[],
+ *          by their birthday and then id
+ */
+int birthdays_on_day(int day, int month);
+
+/*
+ * Function that finds the individuals having their birthday in the days starting from a date
+ * ------------
+ *
+ * Parameters :
+ *          1) A struct tm pointer from, the first of the days
+ *          2) The number of days, atmost a whole year is looked at
+ * ------------
+ *
+ * Returns :
+ *          The number of individuals found, or -1 if the date isn't valid or memory allocation failed. They are left
+ *          in found_nodes[], by the day of their birthday, the oldest first
+ * ------------
+ *
+ * The days are walked through on the calendar, one bucket each. Birthdays on the 29th of February are had on the
+ * 28th in the years that aren't leap years
+ */
+int upcoming_birthdays(struct tm *from, int days);
+
+/*
+ * Function that prints the individuals having their birthday in the days starting from a date
+ * ------------
+ *
+ * Parameters :
+ *          1) A struct tm pointer from, the first of the days
+ *          2) The number of days
+ * ------------
+ *
+ * Returns :
+ *          Prints out the individuals found, by the day of their birthday
+ * ------------
+ */
+void print_upcoming_birthdays(struct tm *from, int days);
+
+/*
+ * Function that adds content , i.e posts, to already present content of a node
+ * ------------
+ *
+ * Parameters :
+ *          There are no required parameters
  * ------------
  *
  * Returns :
  *          Returns nothing but modifies the content of the node required
  * ------------
  *
- * The function takes the input of id inside it and iterates over all ndoes to find a match.
- * Once a match is foudn, it takes the input for the new content, and add it to the already
- * pre- existing content .
+ * The function takes the input of id and the new content inside it, and adds it to the already
+ * pre- existing content through post_content().
+ *
+ * The post is kept as a record of it's own in the node's post log (see post_log_append()), so the
+ * content posted before it is never copied. It is shown after the earlier ones, two new lines apart.
  *
- * Two new-line characters are added to differatiate betwwen various posts. Memory allocation
- * and size issues are completely taken care of while concatenating them.
+ * If a blocklist is loaded, the blocked phrases found in the post are printed.
  *
  */
 void add_content();
@@ -532,12 +2598,61 @@ void add_content();
  *          Prints out all the nodes which have the given string as a substring in their content
  * ------------
  *
- * The function uses the 'strstr' function from the string.h library to check is the given string is a
- * substring of a node's content. If so, the node is then printed out
+ * The trigrams of the string are looked up in the trigram index, and only the nodes having all of them are checked
+ * with 'strstr'. A string shorter than three characters has no trigrams, so the content arena is scanned instead with
+ * the substring kernel chosen by substring_kernel_select().
  *
  */
 void search_for_content(char string[]);
 
+/*
+ * Function that searches for the nodes using some words or phrases in their content
+ * ------------
+ *
+ * Parameters :
+ *          A string query, words separated by spaces. Words inside double quotes have to appear one after the other
+ * ------------
+ *
+ * Returns :
+ *          Prints out all the nodes whose content has every word of the query, in any case
+ * ------------
+ *
+ * Answered by intersecting the posting lists of the words, only the nodes left are checked for the phrases
+ */
+void search_for_words(char query[]);
+
+/*
+ * Function that checks all the contents against a blocklist
+ * ------------
+ *
+ * Parameters :
+ *          A string path, of the file with the blocked phrases, one per line
+ * ------------
+ *
+ * Returns :
+ *          Prints out every node along with the blocked phrases in it's content. The blocklist stays loaded, so that
+ *          add_content() warns about the blocked phrases in the posts made later
+ * ------------
+ */
+void check_blocklist(char path[]);
+
+/*
+ * Function that finds the nodes whose content matches a query
+ * ------------
+ *
+ * Parameters :
+ *          1) A string query
+ *          2) 0 to match the query as a substring, as search_for_content() does, or 1 to match it as words and
+ *             phrases, as search_for_words() does
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes found, or -1 if memory allocation failed. The nodes are left in found_nodes[] in
+ *          the order of the global lists
+ * ------------
+ */
+int content_search(char query[], int whole_words);
+
 /*
  * Function that prints out all the nodes present in the system now
  * ------------
@@ -555,6 +2670,22 @@ void search_for_content(char string[]);
  */
 void print_all();
 
+/*
+ * Function that removes a node with a given id, without any input from the user
+ * ------------
+ *
+ * Parameters :
+ *          An integer id, the id of the node to be deleted
+ * ------------
+ *
+ * Returns :
+ *          1 if the node was deleted, 0 if there is no node with the id
+ * ------------
+ *
+ * Works exactly like delete_node(), which only takes the input of the id and calls this function
+ */
+int remove_node(int id);
+
 /*
  * Function that deletes a given node
  * ------------
@@ -576,4 +2707,284 @@ void print_all();
  */
 void delete_node();
 
+/*
+ * Function that packs the nodes and linked cells into as few slabs as possible
+ * ------------
+ *
+ * Parameters : None
+ * ------------
+ *
+ * Returns :
+ *          The number of slabs given back to the system
+ * ------------
+ *
+ * Nodes and cells are moved to the holes left by deleted ones, and every pointer to a moved object is fixed through
+ * the ID index, the name index, the pprev of the global lists and the pprev and twin of the cells
+ */
+size_t compact_memory();
+
+/*
+ * Function that deletes many nodes at once
+ * ------------
+ *
+ * Parameters :
+ *          1) An array of the ids of the nodes to be deleted. Ids that don't exist are skipped
+ *          2) The number of ids in the array
+ * ------------
+ *
+ * Returns :
+ *          The number of nodes deleted
+ * ------------
+ *
+ * Each node is removed as by remove_node(), which only touches the node's own links, and the memory is compacted
+ * once at the end rather than leaving a hole for every node
+ */
+int remove_nodes(int *ids, int count);
+
+/*
+ * Function that runs a single command of the batch language
+ * ------------
+ *
+ * Parameters :
+ *          A string line, holding the command. The line is modified while it is split into it's fields
+ * ------------
+ *
+ * Returns :
+ *          NULL if the command ran, otherwise a message telling what was wrong with it
+ * ------------
+ *
+ * A command is made of fields separated by '|', the first of which is the name of the command.
+ * The content of a node or post is always the last field and may contain '|' itself.
+ *
+ *      create|Individual|<id>|<name>|<DD/MM/YYYY creation>|<DD/MM/YYYY birthday or ->|<content>
+ *      create|<Business, Organisation or Group>|<id>|<name>|<DD/MM/YYYY creation>|<x>|<y>|<content>
+ *      link|<business, organisation or group id>|<member id>[|owner, customer or member]
+ *      post|<id>|<content>
+ *      post-at|<id>|<seconds since the epoch>|<content>   how the log records posts, so that they keep their time
+ *      search|<name or type>        prints the ids of the matching nodes
+ *      one-hop|<id>                 prints the ids of the one-hop nodes
+ *      two-hop|<individual id>      prints the ids of the two-hop nodes
+ *      k-hop|<id>|<hops>            prints the ids of the nodes within the hops, nearest first
+ *      k-hop-count|<id>|<hops>      prints the number of nodes at each distance, up to the farthest node reached
+ *      threads|<count>              sets the number of threads the k-hop queries run on, see thread_pool_start()
+ *      path|<id>|<id>               prints the ids of the nodes on the shortest path, an empty line if there is none
+ *      connected|<id>|<id>          prints 1 if the nodes are connected, 0 otherwise
+ *      components                   prints <id>:<size> for every connected component, the biggest first
+ *      pagerank[|<damping>|<tolerance>|<iterations>]  scores the nodes, 0.85, 1e-6 and 100 by default, prints the iterations run
+ *      pagerank-refresh[|<damping>|<tolerance>|<iterations>]  the same in the background, see pagerank_refresh()
+ *      top|<type or any>|<count>    prints the ids of the nodes with the highest scores
+ *      score|<id>                   prints the score of a node
+ *      delete|<id>
+ *      load|<nodes or edges>|<path>  see load_nodes() and load_edges()
+ *      load|snapshot|<path>          see load_snapshot()
+ *      save|<path>                   saves a snapshot
+ *      delete-many|<id> <id> ...     deletes all the nodes, then compacts the memory once
+ *      compact                       see compact_memory()
+ *      content|<string>              prints the ids of the nodes with the string in their content
+ *      words|<words or "phrases">    prints the ids of the nodes using all the words
+ *      bench|<string>|<rounds>       times a scan of every content for the string, with strstr() and each kernel
+ *      blocklist|<path>              see blocklist_load()
+ *      blocked                       prints <id>:<line> for every blocked phrase in every content, by it's line in the blocklist
+ *      flagged                       prints <id>:<line> for every blocked phrase posted so far
+ *      posts|<id>[|<first>|<count>]  prints the posts of a node from the first one (0 by default), one per line
+ *      feed|<id>|<count>             prints <id>|<time>|<post> for the latest posts of the one-hop nodes, one per line
+ *      near|<id>|<type or any>|<count>     prints the ids of the nodes nearest to a node, nearest first
+ *      within|<type or any>|<x>|<y>|<radius>  prints the ids of the nodes within the radius, nearest first
+ *      box|<type or any>|<x1>|<y1>|<x2>|<y2>  prints the ids of the nodes inside the box
+ *      birthday|<DD/MM/YYYY>               prints the ids of the individuals born on the date
+ *      birthday-any|<DD/MM>                prints the ids of the individuals born on the day, of any year
+ *      upcoming|<DD/MM/YYYY>|<days>        prints the ids of the individuals having their birthday in the days from the date
+ *
+ * Queries print a single line of space separated ids, nothing else is printed
+ */
+char *run_command(char *line);
+
+/*
+ * Function that runs all the commands in a file, one per line
+ * ------------
+ *
+ * Parameters :
+ *          A FILE pointer to read the commands from, such as stdin
+ * ------------
+ *
+ * Returns :
+ *          The number of commands that failed. Each failure is reported on stderr along with it's line number
+ * ------------
+ *
+ * Empty lines and lines starting with '#' are skipped. The input is read in big blocks so that millions of
+ * commands, such as a replayed trace, can be run without the menu and it's prompts
+ */
+int run_batch(FILE *input);
+
+/*
+ * Function that loads the nodes in a CSV file
+ * ------------
+ *
+ * Parameters :
+ *          A FILE pointer to the file. It is read twice, so it can't be stdin
+ * ------------
+ *
+ * Returns :
+ *          The number of lines that couldn't be loaded, or -1 if memory allocation failed
+ * ------------
+ *
+ * Each line has the same fields as the create command, separated by ',' instead of '|'
+ *
+ *      Individual,<id>,<name>,<DD/MM/YYYY creation>,<DD/MM/YYYY birthday or ->,<content>
+ *      <Business, Organisation or Group>,<id>,<name>,<DD/MM/YYYY creation>,<x>,<y>,<content>
+ *
+ * The content is the rest of the line and may contain ',', the name may not. The first pass only counts the nodes
+ * of each kind, so that the ID index, the name indexes and the node pools are sized once before any node is created
+ */
+int load_nodes(FILE *input);
+
+/*
+ * Function that loads the links in an edge list file
+ * ------------
+ *
+ * Parameters :
+ *          A FILE pointer to the file
+ * ------------
+ *
+ * Returns :
+ *          The number of lines that couldn't be loaded, or -1 if memory allocation failed
+ * ------------
+ *
+ * Each line holds the id of a business, organisation or group, the id of the member and optionally the role
+ * (owner, customer or member), separated by spaces, tabs or ','
+ *
+ *      <container id> <member id> [owner, customer or member]
+ *
+ * Both ids are looked up in the ID index as the file is read, so the nodes have to be loaded first. Once the whole
+ * file is read the number of cells of each kind is known, the cell pools are sized for them and the links are made
+ */
+int load_edges(FILE *input);
+
+/*
+ * Function that saves all the nodes and links to a snapshot file
+ * ------------
+ *
+ * Parameters :
+ *          A string path, the file to save to. It is replaced only once the whole snapshot has been written
+ * ------------
+ *
+ * Returns :
+ *          1 if the snapshot was saved, 0 otherwise
+ * ------------
+ */
+int save_snapshot(char *path);
+
+/*
+ * Function that loads a snapshot file saved by save_snapshot()
+ * ------------
+ *
+ * Parameters :
+ *          A string path, the snapshot file
+ * ------------
+ *
+ * Returns :
+ *          1 if the snapshot was loaded, 0 if the network isn't empty, the file isn't a valid snapshot of this version
+ *          or memory allocation failed. Nothing is left behind when it fails
+ * ------------
+ *
+ * The file is mapped into memory and stays mapped. The names, contents, dates and posts of the nodes point straight
+ * into the mapping, and only the nodes and their link cells are allocated (each pool sized once up front). Only the ID
+ * index is filled in, to check that the ids are unique. The other indexes are left for index_require(), so the strings,
+ * dates and times are only read from the disk once they are first used. Only the header, and the offsets in the node
+ * records and links, are checked before the nodes are made
+ */
+int load_snapshot(char *path);
+
+/*
+ * Function that adds the nodes to indexes they were left out of by load_snapshot()
+ * ------------
+ *
+ * Parameters :
+ *          An integer indexes, the INDEX_* flags of the indexes about to be used
+ * ------------
+ *
+ * Returns :
+ *          1 if the indexes are built, 0 if memory allocation failed, in which case they are left out till the next use
+ * ------------
+ *
+ * Called by the lookups of every index. Till an index is built adding or removing a node doesn't touch it, as it is
+ * built from the global lists as they are by then
+ */
+int index_require(int indexes);
+
+/*
+ * Function that writes a change to the operation log
+ * ------------
+ *
+ * Parameters :
+ *          A printf style format and it's arguments, making up a single command of the batch language. Only the %d,
+ *          %lld, %s and %.17g style conversions are supported
+ * ------------
+ *
+ * Returns :
+ *          Nothing. Does nothing if no log is open or logging is paused. Called by create_node(), link_member(),
+ *          post_content() and remove_node() once the change has been made, so every way of changing the network is logged
+ * ------------
+ *
+ * Every %s argument is escaped, so a name or content containing '|' or a new line is replayed as it was. While a bulk
+ * load holds the log the record isn't synced, the load syncs them all once it's done
+ */
+void wal_record(char *format, ...);
+
+/*
+ * Function that makes every record written to the log so far durable
+ * ------------
+ *
+ * Parameters : None
+ * ------------
+ *
+ * Returns :
+ *          1 if the records were synced (or there is no log), 0 otherwise
+ * ------------
+ */
+int wal_sync();
+
+/*
+ * Function that empties the log once it's records are part of a snapshot
+ * ------------
+ *
+ * Parameters : None
+ * ------------
+ *
+ * Returns :
+ *          1 if the log was emptied, 0 otherwise. Called by save_snapshot() after the snapshot is safely on the disk
+ * ------------
+ */
+int wal_reset();
+
+/*
+ * Function that replays a log and then keeps logging every change to it
+ * ------------
+ *
+ * Parameters :
+ *          1) A string path, the log file. It is created if it doesn't exist
+ *          2) An integer sync_every, the number of records per fsync (0 leaves the syncing to the system)
+ * ------------
+ *
+ * Returns :
+ *          1 if the log is open, 0 if it couldn't be opened or continues from a newer snapshot than the one loaded
+ * ------------
+ *
+ * Has to be called after load_snapshot(), if a snapshot is used. A record cut off half way by a crash is dropped first
+ */
+int wal_open(char *path, int sync_every);
+
+/*
+ * Function that syncs and closes the log
+ * ------------
+ *
+ * Parameters : None
+ * ------------
+ *
+ * Returns :
+ *          Nothing. Registered with atexit() by wal_open()
+ * ------------
+ */
+void wal_close();
+
 #endif // SOCIAL_H
\ No newline at end of file